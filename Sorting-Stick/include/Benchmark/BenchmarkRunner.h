@@ -0,0 +1,39 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+namespace Benchmark
+{
+	// Headless measurements selected with --benchmark=<name>. They run instead of the game and print
+	// their results as a table; --sticks sets the input size and --seed the input.
+	class BenchmarkRunner
+	{
+	private:
+		static const int default_number_of_values = 1 << 24;
+
+		static int getNumberOfValues();
+		static std::uint64_t getSeed();
+		static std::vector<int> generateRandomValues(int number_of_values);
+
+		template<typename Float>
+		static void addSpecialFloats(std::vector<Float>& keys, std::uint64_t seed);
+		template<typename Key>
+		static void runKeyTypeBenchmark(const char* key_name, const std::vector<Key>& input);
+		template<typename Key>
+		static void runRadixKeyTypeBenchmark(const char* key_name, const std::vector<Key>& input);
+
+		static void runMergeBenchmark();
+		static void runKeyTypesBenchmark();
+		static void runRecordsBenchmark();
+		static void runStabilityBenchmark();
+		static void runSelectionBenchmark();
+		static void runRadixBenchmark();
+		static void runParallelBenchmark();
+		static void runNumaBenchmark();
+		static void runHugePagesBenchmark();
+
+	public:
+		// Returns the process exit code.
+		static int runFromCommandLine();
+	};
+}
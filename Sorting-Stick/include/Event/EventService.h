@@ -19,12 +19,25 @@ namespace Event
 
 		ButtonState left_mouse_button_state;
 		ButtonState right_mouse_button_state;
+		ButtonState space_key_state;
+		ButtonState left_arrow_key_state;
+		ButtonState right_arrow_key_state;
+		ButtonState up_arrow_key_state;
+		ButtonState down_arrow_key_state;
+		ButtonState f3_key_state;
+		ButtonState f4_key_state;
+		ButtonState f5_key_state;
+		ButtonState f6_key_state;
+		ButtonState f7_key_state;
+		ButtonState f8_key_state;
+		ButtonState f9_key_state;
 
 		bool isGameWindowOpen();
 		bool gameWindowWasClosed();
 		bool hasQuitGame();
 		bool isKeyboardEvent();
 		void updateMouseButtonsState(ButtonState& current_button_state, sf::Mouse::Button mouse_button);
+		void updateKeyboardButtonsState(ButtonState& current_button_state, sf::Keyboard::Key keyboard_button);
 
 	public:
 		EventService();
@@ -35,10 +48,18 @@ namespace Event
 		void processEvents();
 
 		bool pressedEscapeKey();
+		bool pressedSpaceKey();
 		bool pressedLeftArrowKey();
 		bool pressedRightArrowKey();
 		bool pressedUpArrowKey();
 		bool pressedDownArrowKey();
+		bool pressedF3Key();
+		bool pressedF4Key();
+		bool pressedF5Key();
+		bool pressedF6Key();
+		bool pressedF7Key();
+		bool pressedF8Key();
+		bool pressedF9Key();
 		bool pressedLeftMouseButton();
 		bool pressedRightMouseButton();
 	};
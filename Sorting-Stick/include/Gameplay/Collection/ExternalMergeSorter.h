@@ -0,0 +1,41 @@
+#pragma once
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace Gameplay
+{
+	namespace Collection
+	{
+		// Sorts a binary file of 32 bit integers that does not have to fit in memory (--external-sort).
+		//
+		// Run generation reads chunks of a third of the budget from the mapped input, sorts each in memory
+		// and spills it to a temporary run file in the background while the next chunk is sorted. The runs
+		// are then merged k ways through a loser tree, every run streaming through its own read-ahead
+		// blocks; more runs than max_merge_fan_in are merged in several passes.
+		class ExternalMergeSorter
+		{
+		private:
+			const std::size_t min_memory_budget = 1 << 20;
+			const std::size_t max_merge_fan_in = 64;
+			const std::size_t min_read_block_values = 1 << 14;
+
+			std::size_t memory_budget;
+			std::string run_directory;
+			int next_run_index;
+
+			std::string createRunPath();
+			bool generateRuns(const std::string& input_path, std::vector<std::string>& run_paths);
+			bool mergeRuns(const std::vector<std::string>& run_paths, const std::string& output_path);
+			void removeRuns(const std::vector<std::string>& run_paths);
+
+		public:
+			ExternalMergeSorter(std::size_t memory_budget, const std::string& run_directory);
+
+			bool sortFile(const std::string& input_path, const std::string& output_path);
+
+			// Runs the sort described by --external-sort, --output and --memory; returns the process exit code.
+			static int sortFromCommandLine();
+		};
+	}
+}
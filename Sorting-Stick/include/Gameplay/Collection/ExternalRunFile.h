@@ -0,0 +1,53 @@
+#pragma once
+#include <cstddef>
+#include <fstream>
+#include <future>
+#include <string>
+#include <vector>
+
+namespace Gameplay
+{
+	namespace Collection
+	{
+		// Sorted runs of an external merge sort, stored as raw 32 bit integers in temporary files.
+		namespace ExternalRunFile
+		{
+			bool writeRun(const std::string& file_path, const std::vector<int>& values);
+
+			// Writes the run on a background task so the caller can start on the next run meanwhile.
+			std::future<bool> writeRunAsync(const std::string& file_path, std::vector<int> values);
+		}
+
+		// Streams one run back in fixed size blocks. The next block is always being read in the background
+		// while the current one is consumed, so the merge only waits when it outruns the disk.
+		class ExternalRunReader
+		{
+		private:
+			std::ifstream run_file;
+			std::size_t block_values;
+
+			std::vector<int> current_block;
+			std::vector<int> next_block;
+			std::size_t read_position;
+			std::future<std::size_t> read_ahead;
+			bool reading_ahead;
+
+			std::size_t readBlock(std::vector<int>& block);
+			void startReadAhead();
+
+		public:
+			ExternalRunReader();
+			~ExternalRunReader();
+
+			ExternalRunReader(const ExternalRunReader&) = delete;
+			ExternalRunReader& operator=(const ExternalRunReader&) = delete;
+
+			bool open(const std::string& file_path, std::size_t block_values);
+			void close();
+
+			bool hasValue() const { return read_position < current_block.size(); }
+			int peekValue() const { return current_block[read_position]; }
+			void advance();
+		};
+	}
+}
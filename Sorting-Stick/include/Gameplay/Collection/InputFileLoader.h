@@ -0,0 +1,33 @@
+#pragma once
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace Gameplay
+{
+	namespace Collection
+	{
+		// Loads sort keys from a file mapped into memory, without going through iostreams.
+		//
+		// Files ending in .bin hold raw little-endian 32 bit integers. Anything else is read as text with
+		// one number per line; for CSV lines the first field is used, and lines that are not a number
+		// (headers, comments) are skipped. Text is split into newline-aligned chunks that are parsed on
+		// separate threads straight into the output.
+		class InputFileLoader
+		{
+		private:
+			static const std::size_t min_bytes_per_thread = 1 << 20;
+
+			static bool isBinaryFile(const std::string& file_path);
+			static bool loadBinary(const unsigned char* data, std::size_t size, std::size_t max_values, std::vector<int>& values);
+			static bool loadText(const unsigned char* data, std::size_t size, std::size_t max_values, std::vector<int>& values);
+
+			static std::size_t countLines(const unsigned char* begin, const unsigned char* end);
+			static std::size_t parseTextChunk(const unsigned char* begin, const unsigned char* end, int* values, std::size_t max_values, std::size_t& skipped_lines);
+			static const unsigned char* parseNumber(const unsigned char* position, const unsigned char* end, int& value);
+
+		public:
+			static bool load(const std::string& file_path, std::size_t max_values, std::vector<int>& values);
+		};
+	}
+}
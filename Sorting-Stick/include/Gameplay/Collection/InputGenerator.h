@@ -0,0 +1,53 @@
+#pragma once
+#include "Gameplay/Collection/StickCollectionModel.h"
+#include <cstdint>
+#include <functional>
+
+namespace Gameplay
+{
+	namespace Collection
+	{
+		// Produces the initial stick values for one input distribution.
+		//
+		// Every value is a pure function of (seed, index): random bits come from SplitMix64 evaluated at a
+		// counter instead of a running state, and the random permutation is a small Feistel network over
+		// the index. Any range of indices can therefore be filled independently, which lets fill() split
+		// the work across threads while the result stays identical for a given seed.
+		class InputGenerator
+		{
+		private:
+			static const int permutation_rounds = 4; // even, so the halves end up back in their original widths
+			static const int min_values_per_thread = 1 << 16;
+
+			const int few_unique_levels = 8;
+			const int sawtooth_teeth = 4;
+			const int nearly_sorted_period = 20; // roughly one element in this many is displaced
+			const int nearly_sorted_window_divisor = 32; // displaced elements move up to n / divisor positions
+			const double gaussian_spread_divisor = 6.0; // +-3 standard deviations span the value range
+
+			InputDistribution distribution;
+			std::uint64_t seed;
+			int number_of_values;
+
+			int permutation_left_bits;
+			int permutation_right_bits;
+			std::uint64_t permutation_round_keys[permutation_rounds];
+
+			static std::uint64_t mixBits(std::uint64_t bits);
+			std::uint64_t randomBits(int index, int stream) const;
+			double randomUnit(int index, int stream) const;
+			std::uint64_t permuteIndex(std::uint64_t index) const;
+			int clampValue(long long value) const;
+
+		public:
+			InputGenerator(InputDistribution distribution, std::uint64_t seed, int number_of_values);
+
+			int valueAt(int index) const;
+
+			// Calls fill_range on disjoint index ranges covering [0, number_of_values), in parallel for large inputs.
+			void fill(const std::function<void(int first_index, int last_index)>& fill_range) const;
+
+			static bool parseDistribution(const char* option_name, InputDistribution& distribution);
+		};
+	}
+}
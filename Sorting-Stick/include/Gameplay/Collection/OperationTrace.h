@@ -0,0 +1,69 @@
+#pragma once
+#include <cstdint>
+
+namespace Gameplay
+{
+	namespace Collection
+	{
+		// Binary operation trace format, written by OperationTraceWriter:
+		//
+		//   char[4] magic "SSTR", varint version, varint sort type, varint element count,
+		//   element count x zigzag varint initial value,
+		//   then one record per operation until the end of the file:
+		//     uint8 operation type, followed by
+		//       COMPARE: zigzag varint (first - previous index), zigzag varint (second - first)
+		//       SWAP:    zigzag varint (first - previous index), zigzag varint (second - first)
+		//       WRITE:   zigzag varint (index - previous index), zigzag varint value
+		//
+		// "previous index" is the first index of the previous record, so the local access patterns
+		// of the sorts encode to one or two bytes per index.
+		enum class OperationType : std::uint8_t
+		{
+			COMPARE,
+			SWAP,
+			WRITE,
+		};
+
+		namespace OperationTrace
+		{
+			const char magic[4] = { 'S', 'S', 'T', 'R' };
+			const std::uint32_t version = 1;
+			const int max_varint_bytes = 10;
+			const int max_record_bytes = 1 + 2 * max_varint_bytes;
+
+			inline std::uint64_t encodeZigZag(std::int64_t value)
+			{
+				return (static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63);
+			}
+
+			inline std::int64_t decodeZigZag(std::uint64_t value)
+			{
+				return static_cast<std::int64_t>(value >> 1) ^ -static_cast<std::int64_t>(value & 1);
+			}
+
+			inline unsigned char* writeVarint(unsigned char* output, std::uint64_t value)
+			{
+				while (value >= 0x80)
+				{
+					*output++ = static_cast<unsigned char>(value | 0x80);
+					value >>= 7;
+				}
+				*output++ = static_cast<unsigned char>(value);
+				return output;
+			}
+
+			// Returns nullptr on truncated or overlong input.
+			inline const unsigned char* readVarint(const unsigned char* input, const unsigned char* end, std::uint64_t& value)
+			{
+				value = 0;
+				for (int shift = 0; shift < 64 && input < end; shift += 7)
+				{
+					unsigned char byte = *input++;
+					value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+					if (!(byte & 0x80)) return input;
+				}
+				return nullptr;
+			}
+		}
+	}
+}
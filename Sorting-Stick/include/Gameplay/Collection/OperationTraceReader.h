@@ -0,0 +1,94 @@
+#pragma once
+#include "Gameplay/Collection/OperationTrace.h"
+#include "Global/MemoryMappedFile.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Gameplay
+{
+	namespace Collection
+	{
+		struct TraceOperation
+		{
+			OperationType type;
+			int first_index;
+			int second; // second index, or the written value for WRITE
+		};
+
+		// Replays a memory-mapped operation trace. Every keyframe_interval operations a keyframe records
+		// the decoder state and, as a sparse undo diff, the old value of every element the following
+		// interval changes. Applying that diff anywhere inside the interval restores the keyframe, so
+		// stepping back costs one diff plus at most keyframe_interval decoded operations whatever the
+		// array size. Full snapshots, limited to max_snapshot_bytes, bound long jumps.
+		class OperationTraceReader
+		{
+		private:
+			struct Keyframe
+			{
+				std::size_t byte_offset;
+				std::int64_t previous_index;
+				std::uint64_t comparisons;
+				std::uint64_t array_accesses;
+				TraceOperation last_operation;
+				std::size_t undo_begin; // first undo entry of the interval that starts here
+			};
+
+			struct UndoEntry
+			{
+				int index;
+				int value;
+			};
+
+			static const std::uint64_t keyframe_interval = 1024;
+			static const std::uint64_t max_snapshot_bytes = 64ull << 20;
+
+			Global::MemoryMappedFile trace_file;
+			const unsigned char* operations_begin;
+			const unsigned char* operations_end;
+
+			int sort_type;
+			std::uint64_t operation_count;
+			std::vector<Keyframe> keyframes;
+			std::vector<UndoEntry> undo_entries;
+			std::uint64_t snapshot_stride; // keyframes between full snapshots
+			std::vector<std::vector<int>> snapshots;
+
+			std::vector<int> values;
+			const unsigned char* cursor;
+			std::int64_t previous_index;
+			std::uint64_t position;
+			std::uint64_t comparisons;
+			std::uint64_t array_accesses;
+			TraceOperation last_operation;
+
+			bool decodeOperation(const unsigned char*& input, std::int64_t& last_index, TraceOperation& operation) const;
+			void applyOperation(const TraceOperation& operation);
+			void restoreKeyframe(std::uint64_t keyframe_index);
+			void undoInterval(std::uint64_t keyframe_index);
+			void stepForward(std::uint64_t operation_index);
+			void buildKeyframes();
+
+		public:
+			OperationTraceReader();
+			~OperationTraceReader();
+
+			bool open(const std::string& file_path);
+			void close();
+			bool isOpen() const { return trace_file.isOpen(); }
+
+			// Moves to the array state after the first operation_index operations.
+			void seek(std::uint64_t operation_index);
+
+			int getSortType() const { return sort_type; }
+			std::uint64_t getOperationCount() const { return operation_count; }
+			std::uint64_t getPosition() const { return position; }
+			std::uint64_t getComparisons() const { return comparisons; }
+			std::uint64_t getArrayAccesses() const { return array_accesses; }
+			const std::vector<int>& getValues() const { return values; }
+
+			// The operation that produced the current state; only meaningful when the position is not 0.
+			const TraceOperation& getLastOperation() const { return last_operation; }
+		};
+	}
+}
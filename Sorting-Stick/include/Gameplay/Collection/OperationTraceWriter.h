@@ -0,0 +1,77 @@
+#pragma once
+#include "Gameplay/Collection/OperationTrace.h"
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Gameplay
+{
+	namespace Collection
+	{
+		// Records the operations of one sort run into a compact binary trace (see OperationTrace.h).
+		//
+		// The sort thread encodes into one of two fixed blocks; when a block fills up it is handed to a
+		// background writer thread and the sort carries on in the other block, so disk I/O only stalls
+		// the sort if the disk is slower than the sort produces operations.
+		class OperationTraceWriter
+		{
+		private:
+			static const std::size_t block_size = 1 << 20;
+
+			std::ofstream trace_file;
+			bool recording;
+
+			std::vector<unsigned char> blocks[2];
+			int active_block;
+			std::size_t write_position;
+			std::int64_t previous_index;
+
+			std::thread writer_thread;
+			std::mutex block_mutex;
+			std::condition_variable block_condition;
+			int pending_block;
+			std::size_t pending_size;
+			bool stop_writer;
+
+			std::uint64_t operations_recorded;
+			std::uint64_t bytes_written;
+
+			void runWriterThread();
+			void submitActiveBlock();
+
+			void recordPair(OperationType type, std::int64_t first, std::int64_t second, bool second_is_index)
+			{
+				if (write_position + OperationTrace::max_record_bytes > block_size) submitActiveBlock();
+
+				unsigned char* output = blocks[active_block].data() + write_position;
+				unsigned char* start = output;
+
+				*output++ = static_cast<unsigned char>(type);
+				output = OperationTrace::writeVarint(output, OperationTrace::encodeZigZag(first - previous_index));
+				output = OperationTrace::writeVarint(output, OperationTrace::encodeZigZag(second_is_index ? second - first : second));
+
+				previous_index = first;
+				write_position += output - start;
+				operations_recorded++;
+			}
+
+		public:
+			OperationTraceWriter();
+			~OperationTraceWriter();
+
+			bool beginTrace(const std::string& file_path, int sort_type, const std::vector<int>& initial_values);
+			void endTrace();
+
+			bool isRecording() const { return recording; }
+			std::uint64_t getOperationsRecorded() const { return operations_recorded; }
+
+			void recordComparison(int first_index, int second_index) { if (recording) recordPair(OperationType::COMPARE, first_index, second_index, true); }
+			void recordSwap(int first_index, int second_index) { if (recording) recordPair(OperationType::SWAP, first_index, second_index, true); }
+			void recordWrite(int index, int value) { if (recording) recordPair(OperationType::WRITE, index, value, false); }
+		};
+	}
+}
@@ -1,24 +1,28 @@
 #pragma once
-#include "UI/UIElement/RectangleShapeView.h"
+#include <SFML/Graphics/Color.hpp>
 
 namespace Gameplay
 {
     namespace Collection
     {
+        // Sticks are stored by value in one contiguous array; the view derives their geometry from data.
         struct Stick
         {
-            int data;
-            UI::UIElement::RectangleShapeView* stick_view;
+            // Sticks are ordered through Sorting::KeyTraits<Key>, like the headless sorting kernels.
+            using Key = int;
 
-            Stick() { }
+            Key data;
+            sf::Color color;
+            int original_index; // position in the input, to verify stability and to break ties in stable sort mode
 
-            Stick(int data)
+            Stick() : data(0), color(sf::Color::White), original_index(0) { }
+
+            Stick(Key data, sf::Color color, int original_index = 0)
             {
                 this->data = data;
-                stick_view = new UI::UIElement::RectangleShapeView();
+                this->color = color;
+                this->original_index = original_index;
             }
-
-            ~Stick() { delete(stick_view); }
         };
     }
-}
\ No newline at end of file
+}
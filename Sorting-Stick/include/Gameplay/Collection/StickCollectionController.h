@@ -1,7 +1,15 @@
 #pragma once
 #include <SFML/Graphics.hpp>
 #include <vector>
+#include <cstdint>
 #include <thread>
+#include <string>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <memory>
+#include "Gameplay/Collection/Stick.h"
+#include "Sorting/StabilityCheck.h"
 
 namespace Gameplay
 {
@@ -9,23 +17,72 @@ namespace Gameplay
     {
         class StickCollectionView;
         class StickCollectionModel;
-        struct Stick;
+        class OperationTraceWriter;
+        class OperationTraceReader;
         enum class SortType;
         enum class SortState;
+        enum class InputDistribution;
+        enum class OperationType : std::uint8_t;
         class StickCollectionController
         {
         private:
             StickCollectionView* collection_view;
             StickCollectionModel* collection_model;
 
-            std::vector<Stick*> sticks;
+            std::vector<Stick> sticks;
+
+            // Keys loaded from a file (--input) replace the generated input until the count or distribution
+            // changes. Race lanes share the loaded keys instead of each loading their own copy.
+            std::shared_ptr<const std::vector<int>> file_input_values;
+            int file_input_min_value;
+            int file_input_max_value;
+
             SortType sort_type;
             SortState sort_state;
 
             std::thread sort_thread;
-
-            int number_of_comparisons;
-            int number_of_array_access;
+            std::atomic<bool> sort_thread_finished;
+            std::atomic<bool> sort_completed; // set as soon as the array is sorted, before the completion sweep
+            std::atomic<Sorting::StabilityCheck> stability_check; // verified when the sort thread finishes
+            int finish_place;
+
+            OperationTraceWriter* operation_trace_writer;
+            static int next_operation_trace_index;
+            static std::atomic<int> next_external_sort_index;
+            std::string last_operation_trace_path;
+
+            OperationTraceReader* operation_trace_reader;
+            double replay_position;
+            float replay_speed;
+            int replay_direction;
+            sf::Clock replay_clock;
+
+            // The swaps and writes of the running sort since it was first paused, so a paused sort can be
+            // stepped backward and forward again. undo_log is a ring of max_undo_entries holding the newest
+            // undo_count of them from undo_begin; undo_position < undo_count means some are currently undone.
+            struct UndoEntry
+            {
+                OperationType type;
+                int first_index;
+                int second_index;
+                Stick previous_stick;
+                Stick written_stick;
+            };
+
+            std::vector<UndoEntry> undo_log;
+            std::size_t undo_begin;
+            std::size_t undo_count;
+            std::size_t undo_position;
+            std::atomic<bool> undo_recording;
+
+            std::atomic<bool> sort_paused;
+            std::mutex step_mutex;
+            std::condition_variable step_condition;
+            int pending_steps;
+            bool sort_thread_waiting;
+
+            long long number_of_comparisons;
+            long long number_of_array_access;
             int current_operation_delay;
 
             int delay_in_ms;
@@ -33,13 +90,46 @@ namespace Gameplay
 
             int color_delay;
 
-            void initializeSticks();
-            float calculateStickWidth();
-            float calculateStickHeight(int array_pos);
-
-            void updateStickPosition();
-            void shuffleSticks();
-            bool compareSticksByData(const Stick* a, const Stick* b) const;
+            void createSticks();
+            int calculateOperationDelay();
+            void sleepForOperationDelay(int delay_in_ms);
+
+            void generateInputValues();
+            void cycleInputDistribution();
+            void toggleStableSortMode();
+            void setValueRange(int min_value, int max_value);
+            bool compareSticksByData(const Stick& a, const Stick& b) const;
+            bool compareSticksByOrder(const Stick& a, const Stick& b) const;
+            Sorting::StabilityCheck checkStability() const;
+            int getSelectionCount() const;
+            void playCompareSound(int array_position);
+
+            // Every mutation and comparison of the sort algorithms goes through these so the run can be traced
+            void recordComparison(int first_index, int second_index);
+            void swapSticks(int first_index, int second_index);
+            void writeStick(int array_position, const Stick& stick);
+
+            void toggleOperationTrace();
+            void beginOperationTrace();
+            void runSortThread(void (StickCollectionController::*sort_function)());
+
+            void toggleReplay();
+            void startReplay();
+            void stopReplay();
+            void updateReplay();
+            void showReplayState();
+
+            void pushUndoEntry(const UndoEntry& entry);
+            UndoEntry& getUndoEntry(std::size_t position);
+            void clearUndoLog();
+            void waitForStep();
+            void processStepInput();
+            void togglePause();
+            void resumeSort();
+            bool isSortThreadWaiting();
+            void stepForward();
+            void stepBackward();
+            void highlightUndoEntry(const UndoEntry& entry);
 
             void resetSticksColor();
             void resetVariables();
@@ -57,20 +147,46 @@ namespace Gameplay
             void update();
             void render();
 
+            // Race lanes: the sticks are laid out inside lane_bounds and drawn through one shared batch.
+            void prepareStickVertices();
+            void appendSticksToBatch(sf::VertexArray& stick_batch);
+            void renderLaneLabel();
+            void setLaneBounds(sf::FloatRect lane_bounds);
+            void setRaceLaneIndex(int race_lane_index);
+
+            void setNumberOfElements(int number_of_elements);
+            void setInputDistribution(InputDistribution distribution);
+            void setInputSeed(std::uint64_t seed);
+            void setStableSortMode(bool stable_sort_mode);
+            bool loadInputFile(const std::string& file_path);
+            void setInputValues(std::shared_ptr<const std::vector<int>> input_values);
+            std::shared_ptr<const std::vector<int>> getInputValues();
+
             void reset();
             void sortElements(SortType sort_type);
 
             SortType getSortType();
-            int getNumberOfComparisons();
-            int getNumberOfArrayAccess();
+            long long getNumberOfComparisons();
+            long long getNumberOfArrayAccess();
 
             int getNumberOfSticks();
+            InputDistribution getInputDistribution();
+            std::uint64_t getInputSeed();
             int getDelayMilliseconds();
-            sf::String getTimeComplexity();
+            const sf::String& getTimeComplexity();
+            const std::string& getLastOperationTracePath();
+
+            bool isSortCompleted();
+            bool isStableSortMode();
+            bool isStableSort();
+            Sorting::StabilityCheck getStabilityCheck();
+            int getFinishPlace();
+            void setFinishPlace(int place);
 
             void setCompletedColor();
             void processBubbleSort();
             void processInsertionSort();
+            void insertionSort(int left, int right);
             void processSelectionSort();
             void processInPlaceMergeSort();
 
@@ -86,10 +202,26 @@ namespace Gameplay
             void quickSort(int low,int high);
 
             void processRadixSort();
-            void countSort(int exponent);
-            void updateStickPosition(int i);
+
+            void processPartialSort();
+            void processNthElement();
+            void quickSelect(int low, int high, int nth);
+            void moveMedianOfThreeToEnd(int low, int high);
+            void processTopK();
+            void siftDownTopK(int root, int heap_size);
+
+            void processExternalMergeSort();
+            void mergeExternalRuns(const std::vector<std::string>& run_paths, const std::vector<int>& run_begins, const std::vector<int>& original_indices);
+
+            void processMultiwayMergeSort();
+            void multiwayMerge(int left, int run_length, int right);
+            int getRadixDigit(const Stick& stick, int min_value, std::uint64_t exponent) const;
+            void countSort(int min_value, std::uint64_t exponent);
             void radixSort();
 
+            void processAmericanFlagSort();
+            void americanFlagSort(int left, int right, int min_value, std::uint64_t exponent);
+
         };
     }
 }
\ No newline at end of file
@@ -1,5 +1,6 @@
 #pragma once
 #include <SFML/Graphics.hpp>
+#include <cstdint>
 
 namespace Gameplay
 {
@@ -8,7 +9,8 @@ namespace Gameplay
         enum class SortState
         {
             SORTING,
-            NOT_SORTING
+            NOT_SORTING,
+            REPLAYING,
 
         };
 
@@ -20,18 +22,128 @@ namespace Gameplay
             MERGE_SORT,
             QUICK_SORT,
             RADIX_SORT,
+            EXTERNAL_MERGE_SORT,
+            MULTIWAY_MERGE_SORT,
+            PARTIAL_SORT,
+            NTH_ELEMENT,
+            TOP_K,
+            AMERICAN_FLAG_SORT,
+            COUNT,
         };
 
+        // stable: equal keys always keep their input order.
+        // stable_variant: the sort only keeps it in stable sort mode (F5), where selection sort rotates the
+        // minimum into place instead of swapping it and quick sort breaks key ties by input position.
+        struct SortTypeInfo
+        {
+            const char* name;
+            const char* option_name; // as given to --race
+            const char* time_complexity;
+            bool stable;
+            bool stable_variant;
+        };
+
+        // Indexed by SortType, in declaration order.
+        inline const SortTypeInfo& getSortTypeInfo(SortType sort_type)
+        {
+            static const SortTypeInfo sort_type_infos[] =
+            {
+                { "Bubble Sort", "bubble", "O(n^2)", true, false },
+                { "Insertion Sort", "insertion", "O(n^2)", true, false },
+                { "Selection Sort", "selection", "O(n^2)", false, true },
+                { "Merge Sort", "merge", "O(n Log n)", true, false },
+                { "Quick Sort", "quick", "O(n Log n)", false, true },
+                { "Radix Sort", "radix", "O(w*(n+k))", true, false },
+                { "External Merge Sort", "external", "O(n Log n)", false, true }, // runs are quick sorted, the merge itself is stable
+                { "Multiway Merge Sort", "multiway", "O(n Log n)", true, false },
+                { "Partial Sort", "partial", "O(n + k Log k)", false, true },
+                { "Nth Element", "nth", "O(n)", false, false },
+                { "Top K", "top-k", "O(n Log k)", false, true },
+                { "American Flag Sort", "american-flag", "O(w*n)", false, false },
+            };
+            return sort_type_infos[static_cast<int>(sort_type)];
+        }
+
+        inline const char* getSortTypeName(SortType sort_type) { return getSortTypeInfo(sort_type).name; }
+
+        inline bool isStableSortType(SortType sort_type, bool stable_sort_mode)
+        {
+            const SortTypeInfo& info = getSortTypeInfo(sort_type);
+            return info.stable || (stable_sort_mode && info.stable_variant);
+        }
+
+        enum class InputDistribution
+        {
+            RANDOM,
+            SORTED,
+            REVERSED,
+            FEW_UNIQUE,
+            ORGAN_PIPE,
+            SAWTOOTH,
+            GAUSSIAN,
+            NEARLY_SORTED,
+            COUNT,
+        };
+
+        inline const char* getInputDistributionName(InputDistribution distribution)
+        {
+            switch (distribution)
+            {
+            case InputDistribution::RANDOM: return "Random";
+            case InputDistribution::SORTED: return "Sorted";
+            case InputDistribution::REVERSED: return "Reversed";
+            case InputDistribution::FEW_UNIQUE: return "Few Unique";
+            case InputDistribution::ORGAN_PIPE: return "Organ Pipe";
+            case InputDistribution::SAWTOOTH: return "Sawtooth";
+            case InputDistribution::GAUSSIAN: return "Gaussian";
+            case InputDistribution::NEARLY_SORTED: return "Nearly Sorted";
+            default: return "";
+            }
+        }
+
+        // Spelling used by --distribution on the command line.
+        inline const char* getInputDistributionOptionName(InputDistribution distribution)
+        {
+            switch (distribution)
+            {
+            case InputDistribution::RANDOM: return "random";
+            case InputDistribution::SORTED: return "sorted";
+            case InputDistribution::REVERSED: return "reversed";
+            case InputDistribution::FEW_UNIQUE: return "few-unique";
+            case InputDistribution::ORGAN_PIPE: return "organ-pipe";
+            case InputDistribution::SAWTOOTH: return "sawtooth";
+            case InputDistribution::GAUSSIAN: return "gaussian";
+            case InputDistribution::NEARLY_SORTED: return "nearly-sorted";
+            default: return "";
+            }
+        }
+
         class StickCollectionModel
         {
         public:
             int number_of_elements = 30;
+            const int min_number_of_elements = 10;
+            const int max_number_of_elements = 100000000;
             const float max_element_height = 820.f;
             float elements_spacing = 25.f; //acttual amount of spacing between sticks
             float space_percentage = 0.40f; //the percentage of the screen space allocated to spacing (0 - 1)
             const float element_y_position = 1020.f;
+
+            sf::FloatRect lane_bounds; // area the sticks are laid out in, the whole play area outside race mode
+            const sf::Vector2f lane_label_offset = sf::Vector2f(10.f, -36.f);
             const long initial_color_delay = 40;
 
+            // Initial values (F6 cycles the distribution). Without a fixed seed every reset draws a new one.
+            InputDistribution input_distribution = InputDistribution::RANDOM;
+            std::uint64_t input_seed = 0;
+            bool fixed_input_seed = false;
+
+            int race_lane_index = -1; // -1 outside race mode; with --pin-threads=1 the lane's sort thread gets its own CPU
+
+            // Smallest and largest key of the current input; stick heights and tone pitch are relative to it.
+            int min_value = 0;
+            int max_value = 29;
+
             const sf::Color element_color = sf::Color::White;
             const sf::Color processing_element_color = sf::Color::Red;
             const sf::Color placement_position_element_color = sf::Color::Green;
@@ -39,6 +151,40 @@ namespace Gameplay
             const sf::Color temporary_elemrnt_color = sf::Color::Yellow;
 
             const long operation_delay = 150;
+            const int delay_reference_elements = 30; // element count that runs at the full operation_delay
+            const int max_sonified_elements = 2048;
+
+            // Above one stick per pixel column the view samples one stick per column.
+            const float min_column_pixel_width = 1.f;
+            const float min_spaced_column_pixel_width = 4.f;
+
+            bool record_operation_trace = false; // toggled with F7
+            const char* const operation_trace_directory = "traces";
+
+            // Replay of the last trace (F8): Left/Right pick the direction, Up/Down double or halve the speed
+            const float min_replay_speed = 1.f; // operations per second
+            const float max_replay_speed = 10000000.f;
+
+            bool stable_sort_mode = false; // toggled with F5, see SortTypeInfo::stable_variant
+
+            // Partial sort orders the smallest and top k the largest selection_fraction of the sticks;
+            // nth element places the median.
+            const float selection_fraction = 0.1f;
+
+            // American flag sort insertion sorts buckets of at most this many sticks instead of recursing
+            const int american_flag_insertion_threshold = 8;
+
+            // Multiway merge sort merges this many runs per pass through a loser tree
+            const int multiway_merge_ways = 8;
+
+            // External merge sort: the collection is cut into this many runs that are spilled to disk and merged back
+            const int external_run_count = 8;
+            const int min_external_run_length = 4;
+            const std::size_t external_read_block_values = 4096;
+            const char* const external_run_directory = "external_runs";
+
+            // Running sorts: Space pauses, and while paused Right/Left step one operation forward/backward
+            const std::size_t max_undo_entries = 1 << 20;
 
             StickCollectionModel();
             ~StickCollectionModel();
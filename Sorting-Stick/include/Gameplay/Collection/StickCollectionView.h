@@ -1,25 +1,50 @@
 #pragma once
 #include <SFML/Graphics.hpp>
 #include "UI/UIElement/ImageView.h"
+#include "UI/UIElement/TextView.h"
+#include "Gameplay/Collection/Stick.h"
+#include <vector>
 
 namespace Gameplay
 {
     namespace Collection
     {
         class StickCollectionController;
+        class StickCollectionModel;
 
         class StickCollectionView
         {
         private:
+            const int lane_label_font_size = 30;
+            const float lane_label_refresh_rate = 15.f;
+
             StickCollectionController* collection_controller;
+            StickCollectionModel* collection_model;
+
+            // One quad per pixel column at most, rewritten in place every frame.
+            sf::VertexArray stick_vertices;
+
+            // Only race lanes have a label, it shows the algorithm, its counters and its finish place.
+            UI::UIElement::TextView* lane_label;
+            bool has_lane_label;
+            sf::Clock lane_label_clock;
+
+            void updateLaneLabel();
 
         public:
             StickCollectionView();
             ~StickCollectionView();
 
-            void initialize(StickCollectionController* collection_controller);
+            void initialize(StickCollectionController* collection_controller, StickCollectionModel* collection_model);
             void update();
             void render();
+
+            void renderSticks(const std::vector<Stick>& sticks);
+
+            // Only touches this view, so race lanes build their vertices in parallel before the batch is assembled.
+            void updateStickVertices(const std::vector<Stick>& sticks);
+            void appendStickVerticesToBatch(sf::VertexArray& stick_batch);
+            void setLaneLabelPosition(sf::Vector2f position);
         };
     }
-}
\ No newline at end of file
+}
@@ -1,6 +1,7 @@
 #pragma once
 #include "Gameplay/Collection/StickCollectionModel.h"
 #include "Gameplay/Collection/StickCollectionController.h"
+#include <vector>
 
 namespace Gameplay
 {
@@ -13,6 +14,26 @@ namespace Gameplay
 		GameplayController* gameplay_controller;
 		StickCollectionController* collection_controller;
 
+		// Race mode: every lane regenerates the input currently shown from the same seed, sticks of all lanes are drawn in one batch.
+		const int min_race_lanes = 2;
+		const int max_race_lanes = 8;
+		const float race_area_top = 170.f;
+		const float race_area_bottom = 1060.f;
+		const float race_lane_label_height = 40.f;
+		const float race_lane_spacing = 20.f;
+
+		bool race_mode;
+		std::vector<Collection::SortType> race_sort_types; // lanes of the menu's race, set with --race
+		std::vector<StickCollectionController*> race_controllers;
+		std::vector<Collection::SortType> race_finish_order;
+		sf::VertexArray race_stick_batch;
+
+		void applyInputOptions();
+		void applyRaceOption();
+		void updateRace();
+		void renderRace();
+		void destroyRace();
+
 	public:
 		GameplayService();
 		~GameplayService();
@@ -23,13 +44,22 @@ namespace Gameplay
 
 		void reset();
 		void sortElement(Collection::SortType search_type);
+		void startRace(const std::vector<Collection::SortType>& sort_types);
+		void setNumberOfSticks(int number_of_sticks);
+
+		bool isRaceMode();
+		int getRaceLaneCount();
+		const std::vector<Collection::SortType>& getRaceSortTypes();
+		const std::vector<Collection::SortType>& getRaceFinishOrder();
 
 		Collection::SortType getSortType();
-		int getNumberOfComparisons();
-		int getNumberOfArrayAccess();
+		long long getNumberOfComparisons();
+		long long getNumberOfArrayAccess();
 		int getNumberOfSticks();
 		int getDelayMilliseconds();
-		sf::String getTimeComplexity();
+		const sf::String& getTimeComplexity();
+		bool isStableSort();
+		Sorting::StabilityCheck getStabilityCheck();
 	};
 }
 
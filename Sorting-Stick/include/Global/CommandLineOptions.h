@@ -0,0 +1,61 @@
+#pragma once
+#include <cstdint>
+
+namespace Global
+{
+	// Options passed as --name=value on the command line; anything not given keeps its default.
+	class CommandLineOptions
+	{
+	private:
+		static int number_of_sticks;
+		static const char* input_distribution;
+		static const char* input_file;
+		static const char* external_sort_input;
+		static const char* output_file;
+		static int memory_budget_mib;
+		static int number_of_threads;
+		static const char* numa_policy;
+		static bool pin_threads;
+		static bool huge_pages;
+		static const char* benchmark;
+		static const char* race_sort_types;
+		static bool has_input_seed;
+		static std::uint64_t input_seed;
+
+		static bool matchOption(const char* argument, const char* name, const char*& value);
+		static bool parseInteger(const char* text, long long min_value, long long max_value, long long& value);
+
+	public:
+		static void parse(int argc, char* argv[]);
+
+		// 0 when --sticks was not given.
+		static int getNumberOfSticks();
+
+		// Raw --distribution name, nullptr when not given; resolved by the gameplay side.
+		static const char* getInputDistribution();
+		// --input=path, nullptr when not given. Files ending in .bin are raw 32 bit integers, anything else text.
+		static const char* getInputFile();
+		// --external-sort=input.bin --output=sorted.bin [--memory=MiB] sorts a file without opening the window.
+		static const char* getExternalSortInput();
+		static const char* getOutputFile();
+		static int getMemoryBudgetMiB();
+
+		// --threads=N sizes the shared worker pool, 0 (the default) uses one worker per hardware thread.
+		static int getNumberOfThreads();
+		// Raw --numa policy name, nullptr when not given; resolved by Threading::NumaMemory.
+		static const char* getNumaPolicy();
+		// --pin-threads=1 pins every pool worker to its own CPU.
+		static bool getPinThreads();
+		// --huge-pages=0 keeps the sort buffers on normal pages, they use huge pages where available otherwise.
+		static bool getHugePages();
+
+		// --benchmark=name runs a headless benchmark instead of the game, nullptr when not given.
+		static const char* getBenchmark();
+
+		// --race=quick,merge,radix picks the 2 to 8 race lanes, nullptr when not given; resolved by the gameplay side.
+		static const char* getRaceSortTypes();
+
+		static bool hasInputSeed();
+		static std::uint64_t getInputSeed();
+	};
+}
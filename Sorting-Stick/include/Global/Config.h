@@ -16,6 +16,7 @@ namespace Global
 		static const sf::String quick_sort_button_texture_path;
 		static const sf::String radix_sort_button_texture_path;
 		static const sf::String quit_button_texture_path;
+		static const sf::String play_button_texture_path;
 		static const sf::String menu_button_large_texture_path;
 
 		static const sf::String bubble_bobble_font_path;
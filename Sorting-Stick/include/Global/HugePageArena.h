@@ -0,0 +1,81 @@
+#pragma once
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include <unordered_map>
+
+namespace Global
+{
+	enum class PageBacking
+	{
+		NORMAL_PAGES,
+		TRANSPARENT_HUGE_PAGES,
+		HUGE_PAGES,
+	};
+
+	struct HugePageArenaStats
+	{
+		std::size_t mapped_bytes;
+		std::size_t cached_bytes;
+		std::size_t fresh_allocations;
+		std::size_t reused_allocations;
+	};
+
+	// Backing store for the large key arrays and scratch buffers. Large blocks are mapped in whole
+	// huge pages: explicit huge pages when the system has some reserved (MAP_HUGETLB, or MEM_LARGE_PAGES
+	// with the lock pages privilege on Windows), otherwise normal pages advised for transparent huge
+	// pages, and plain pages as the last resort. One 2 MiB TLB entry then covers what 512 entries do
+	// with 4 KiB pages, which is what the scatter passes of a radix sort over a big array miss on.
+	//
+	// Released blocks are kept and handed out again, so a sort that runs repeatedly pays for its page
+	// faults and page zeroing once.
+	class HugePageArena
+	{
+	private:
+		struct Block
+		{
+			std::size_t bytes;
+			PageBacking backing;
+		};
+
+		// Smaller blocks use normal pages: rounding them up to a huge page wastes more than the TLB saves.
+		const std::size_t min_huge_page_block_bytes = 1 << 20;
+		const std::size_t max_cached_bytes = std::size_t(1) << 30;
+
+		std::mutex arena_mutex;
+		bool huge_pages_enabled;
+		bool explicit_huge_pages_failed;
+		std::size_t page_bytes;
+		std::size_t huge_page_bytes;
+
+		std::unordered_map<void*, Block> blocks;
+		std::multimap<std::size_t, void*> cached_blocks;
+		HugePageArenaStats stats;
+
+		HugePageArena();
+		~HugePageArena();
+
+		void* mapBlock(std::size_t bytes, PageBacking& backing);
+		void unmapBlock(void* memory, const Block& block);
+		void trimLocked();
+
+	public:
+		static HugePageArena* getInstance();
+
+		// Applies to blocks mapped from now on; cached blocks are dropped so they are not reused.
+		void setHugePagesEnabled(bool enabled);
+		bool areHugePagesEnabled();
+
+		// Returns at least bytes of page aligned memory, or nullptr. fresh is set when the block was
+		// just mapped, so it is zeroed and none of its pages has been placed yet.
+		void* allocate(std::size_t bytes, bool& fresh);
+		void release(void* memory);
+		// Unmaps every cached block.
+		void trim();
+
+		PageBacking getPageBacking(const void* memory);
+		HugePageArenaStats getStats();
+
+		static const char* getPageBackingName(PageBacking backing);
+	};
+}
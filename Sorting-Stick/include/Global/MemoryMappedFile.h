@@ -0,0 +1,38 @@
+#pragma once
+#include <cstddef>
+#include <string>
+
+namespace Global
+{
+	// Read-only view of a whole file mapped into memory.
+	class MemoryMappedFile
+	{
+	private:
+		const unsigned char* data;
+		std::size_t size;
+
+#ifdef _WIN32
+		void* file_handle;
+		void* mapping_handle;
+#else
+		int file_descriptor;
+#endif
+
+	public:
+		MemoryMappedFile();
+		~MemoryMappedFile();
+
+		MemoryMappedFile(const MemoryMappedFile&) = delete;
+		MemoryMappedFile& operator=(const MemoryMappedFile&) = delete;
+
+		bool open(const std::string& file_path);
+		void close();
+
+		// Hints that the file will be read front to back, so the OS reads ahead more aggressively.
+		void adviseSequentialAccess();
+
+		bool isOpen() const { return data != nullptr; }
+		const unsigned char* getData() const { return data; }
+		std::size_t getSize() const { return size; }
+	};
+}
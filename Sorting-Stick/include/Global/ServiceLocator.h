@@ -4,6 +4,9 @@
 #include "UI/UIService.h"
 #include "Sound/SoundService.h"
 #include "Gameplay/GameplayService.h"
+#include "Profiling/ProfilingService.h"
+#include "Resource/ResourceService.h"
+#include "Threading/TaskScheduler.h"
 
 namespace Global
 {
@@ -15,11 +18,17 @@ namespace Global
         Sound::SoundService* sound_service;
         UI::UIService* ui_service;
         Gameplay::GameplayService* gameplay_service;
+        Profiling::ProfilingService* profiling_service;
+        Resource::ResourceService* resource_service;
+        Threading::TaskScheduler* task_scheduler;
+
+        bool asset_dependent_services_initialized;
 
         ServiceLocator();
         ~ServiceLocator();
 
         void createServices();
+        void initializeAssetDependentServices();
         void clearAllServices();
 
     public:
@@ -29,11 +38,16 @@ namespace Global
         void update();
         void render();
 
+        bool areAssetsReady();
+
         Event::EventService* getEventService();
         Graphics::GraphicService* getGraphicService();
         Sound::SoundService* getSoundService();
         UI::UIService* getUIService();
         Gameplay::GameplayService* getGameplayService();
+        Profiling::ProfilingService* getProfilingService();
+        Resource::ResourceService* getResourceService();
+        Threading::TaskScheduler* getTaskScheduler();
         
     };
 }
\ No newline at end of file
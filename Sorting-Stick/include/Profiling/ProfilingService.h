@@ -0,0 +1,53 @@
+#pragma once
+#include <SFML/System/Clock.hpp>
+#include <cstddef>
+#include <string>
+
+namespace Profiling
+{
+	class ProfilingService
+	{
+	private:
+		const std::string trace_file_prefix = "sorting_stick_trace_";
+
+		static const int frame_history_size = 240;
+
+		int trace_dump_count;
+
+		sf::Clock frame_clock;
+		sf::Clock phase_clock;
+
+		float frame_times_ms[frame_history_size];
+		int frame_history_index;
+
+		float frame_time_ms;
+		float update_time_ms;
+		float render_time_ms;
+
+		int draw_calls_this_frame;
+		int draw_calls_last_frame;
+
+		void dumpTrace();
+
+	public:
+		ProfilingService();
+		~ProfilingService();
+
+		void initialize();
+		void update();
+
+		void beginFrame();
+		void endUpdate();
+		void endRender();
+		void recordDrawCall() { draw_calls_this_frame++; }
+
+		float getFrameTimeMilliseconds();
+		float getUpdateTimeMilliseconds();
+		float getRenderTimeMilliseconds();
+		int getDrawCallCount();
+
+		// Buckets are bucket_width_ms wide; the last bucket also counts every slower frame.
+		void getFrameTimeHistogram(int* bucket_counts, int bucket_count, float bucket_width_ms);
+		std::size_t getProcessMemoryBytes();
+	};
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+namespace Profiling
+{
+	// Counts the data TLB misses, loads and stores, of the calling thread between start() and stop()
+	// through perf_event_open. Only available on Linux, and only where the kernel exposes the
+	// hardware cache events to user space (perf_event_paranoid of 2 or lower, not every VM does).
+	class TlbMissCounter
+	{
+	private:
+		static const int event_count = 2;
+		int event_files[event_count];
+
+	public:
+		TlbMissCounter();
+		~TlbMissCounter();
+
+		TlbMissCounter(const TlbMissCounter&) = delete;
+		TlbMissCounter& operator=(const TlbMissCounter&) = delete;
+
+		bool isAvailable() const;
+		void start();
+		// Misses since start(), -1 when the counter is not available.
+		long long stop();
+	};
+}
@@ -0,0 +1,104 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#define TRACE_HAS_TSC 1
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define TRACE_HAS_TSC 1
+#endif
+
+// Scoped trace markers are only compiled in when SORTING_STICK_ENABLE_TRACE is defined.
+// Without it, TRACE_SCOPE and TRACE_THREAD_NAME expand to nothing.
+#ifdef SORTING_STICK_ENABLE_TRACE
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+#define TRACE_SCOPE(name) Profiling::TraceScope TRACE_CONCAT(trace_scope_, __LINE__)(name)
+#define TRACE_THREAD_NAME(name) Profiling::TraceRecorder::setThreadName(name)
+#else
+#define TRACE_SCOPE(name)
+#define TRACE_THREAD_NAME(name)
+#endif
+
+namespace Profiling
+{
+	// One ring slot. The fields are relaxed atomics guarded by sequence, which holds the event's index
+	// plus one once it is complete and 0 while it is being written, so a dump can skip torn slots.
+	struct TraceEvent
+	{
+		std::atomic<std::uint64_t> sequence{ 0 };
+		std::atomic<const char*> name{ nullptr };
+		std::atomic<std::uint32_t> thread_id{ 0 };
+		std::atomic<std::int64_t> start_ticks{ 0 };
+		std::atomic<std::int64_t> duration_ticks{ 0 };
+	};
+
+	class TraceRecorder
+	{
+	private:
+		static constexpr std::uint32_t ring_capacity = 1u << 16; // must be a power of two
+		static constexpr std::uint32_t max_thread_names = 32;
+
+		static TraceEvent ring_buffer[ring_capacity];
+		static std::atomic<std::uint64_t> write_index;
+
+		static std::atomic<const char*> thread_names[max_thread_names];
+		static std::atomic<std::uint32_t> next_thread_id;
+
+		static const std::chrono::steady_clock::time_point epoch_time;
+		static const std::int64_t epoch_ticks;
+
+		static double getNanosecondsPerTick();
+
+	public:
+		// Raw timestamp: the CPU time-stamp counter where available (a few ns to read),
+		// otherwise steady_clock nanoseconds. Converted to wall time only when dumping.
+		static std::int64_t now()
+		{
+#ifdef TRACE_HAS_TSC
+			return static_cast<std::int64_t>(__rdtsc());
+#else
+			return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+		}
+
+		static std::uint32_t getThreadId();
+		static void setThreadName(const char* name);
+
+		// Name must be a string literal (only the pointer is stored).
+		static void record(const char* name, std::int64_t start_ticks, std::int64_t end_ticks)
+		{
+			std::uint64_t index = write_index.fetch_add(1, std::memory_order_relaxed);
+			TraceEvent& event = ring_buffer[index & (ring_capacity - 1)];
+
+			event.sequence.store(0, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_release);
+			event.name.store(name, std::memory_order_relaxed);
+			event.thread_id.store(getThreadId(), std::memory_order_relaxed);
+			event.start_ticks.store(start_ticks, std::memory_order_relaxed);
+			event.duration_ticks.store(end_ticks - start_ticks, std::memory_order_relaxed);
+			event.sequence.store(index + 1, std::memory_order_release);
+		}
+
+		static std::uint64_t getRecordedEventCount();
+		static bool dumpChromeTrace(const std::string& file_path);
+	};
+
+	class TraceScope
+	{
+	private:
+		const char* name;
+		std::int64_t start_ticks;
+
+	public:
+		explicit TraceScope(const char* name) : name(name), start_ticks(TraceRecorder::now()) { }
+		~TraceScope() { TraceRecorder::record(name, start_ticks, TraceRecorder::now()); }
+
+		TraceScope(const TraceScope&) = delete;
+		TraceScope& operator=(const TraceScope&) = delete;
+	};
+}
@@ -0,0 +1,45 @@
+#pragma once
+#include "Global/MemoryMappedFile.h"
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+
+namespace Resource
+{
+	struct AssetArchiveEntry
+	{
+		const unsigned char* data;
+		std::size_t size;
+	};
+
+	// Memory-mapped assets.pak produced by tools/pack_assets.py.
+	//
+	// Layout (little endian):
+	//   char[4] magic "SSPK", uint32 version, uint32 entry_count,
+	//   entry_count x { uint32 path_length, char[path_length] path, uint64 offset, uint64 size },
+	//   followed by the file contents at the recorded offsets.
+	// Paths are stored exactly as they appear in Config, e.g. "assets/textures/play_button.png".
+	class AssetArchive
+	{
+	private:
+		static const char archive_magic[4];
+		static const std::uint32_t archive_version = 1;
+
+		Global::MemoryMappedFile archive_file;
+		std::unordered_map<std::string, AssetArchiveEntry> entries;
+
+		bool readIndex();
+
+	public:
+		static const char* const default_archive_name;
+
+		// Directory of the running executable, so the archive does not depend on the working directory.
+		static std::string getExecutableDirectory();
+
+		bool open(const std::string& archive_path);
+		void close();
+
+		bool isOpen() const { return archive_file.isOpen(); }
+		const AssetArchiveEntry* find(const std::string& asset_path) const;
+	};
+}
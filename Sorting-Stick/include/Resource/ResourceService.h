@@ -0,0 +1,103 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <SFML/Audio.hpp>
+#include "Resource/AssetArchive.h"
+#include "Threading/TaskScheduler.h"
+#include <atomic>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Resource
+{
+	enum class AssetType
+	{
+		TEXTURE,
+		FONT,
+		SOUND_BUFFER,
+	};
+
+	// An asset decoded on a pool worker and waiting for its main-thread upload.
+	struct PendingAsset
+	{
+		std::string path;
+		AssetType type;
+
+		sf::Image image;
+		sf::Font* font = nullptr;
+		std::vector<sf::Int16> samples;
+		unsigned int channel_count = 0;
+		unsigned int sample_rate = 0;
+
+		bool decode_succeeded = false;
+		float decode_time_ms = 0.f;
+		std::atomic<bool> decoded{ false };
+		bool uploaded = false;
+	};
+
+	// Loads every texture, font and sound buffer once, keyed by its path, and hands out
+	// pointers to the shared instance. The service owns the resources for the lifetime of the game.
+	//
+	// Assets are read from the memory-mapped assets.pak next to the executable when it exists,
+	// and from the loose files under assets/ otherwise.
+	//
+	// Assets listed in Config are decoded on the shared worker pool from initialize() onwards;
+	// the GPU/audio-device uploads happen on the main thread in update(). Asking for an asset
+	// that is still in flight finishes it immediately instead of loading it twice.
+	class ResourceService
+	{
+	private:
+		const float upload_budget_ms_per_frame = 4.f;
+
+		AssetArchive asset_archive;
+
+		std::unordered_map<std::string, sf::Texture*> textures;
+		std::unordered_map<std::string, sf::Font*> fonts;
+		std::unordered_map<std::string, sf::SoundBuffer*> sound_buffers;
+
+		std::vector<PendingAsset*> pending_assets;
+		std::unordered_map<std::string, PendingAsset*> pending_assets_by_path;
+		Threading::TaskGroup loader_tasks;
+		std::size_t uploaded_asset_count;
+
+		int resources_loaded;
+		float total_load_time_ms;
+
+		void queueAsset(const sf::String& path, AssetType type);
+		void startLoaderTasks();
+		void decodeAsset(PendingAsset* asset);
+		void uploadAsset(PendingAsset* asset);
+		void finishPendingAsset(const std::string& path);
+		void waitForLoaderTasks();
+
+		void openAssetArchive();
+
+		template<typename ResourceType>
+		bool loadResource(ResourceType* resource, const std::string& path);
+
+		template<typename ResourceType>
+		ResourceType* getOrLoad(std::unordered_map<std::string, ResourceType*>& cache, const sf::String& path);
+
+		void reportLoad(const std::string& path, float load_time_ms, bool succeeded);
+
+		template<typename ResourceType>
+		void clearCache(std::unordered_map<std::string, ResourceType*>& cache);
+		void destroy();
+
+	public:
+		ResourceService();
+		~ResourceService();
+
+		void initialize();
+		void update();
+
+		bool isLoadingComplete();
+
+		sf::Texture* getTexture(const sf::String& path);
+		sf::Font* getFont(const sf::String& path);
+		sf::SoundBuffer* getSoundBuffer(const sf::String& path);
+
+		int getLoadedResourceCount();
+		float getTotalLoadTimeMilliseconds();
+	};
+}
@@ -0,0 +1,91 @@
+#pragma once
+#include "Sorting/KeyTraits.h"
+#include <cstddef>
+#include <utility>
+
+namespace Sorting
+{
+	// Buckets up to this size are finished with insertion sort instead of another radix pass.
+	const std::size_t american_flag_insertion_threshold = 32;
+
+	template<typename Key>
+	void insertionSortByKey(Key* data, std::size_t count)
+	{
+		for (std::size_t i = 1; i < count; i++)
+		{
+			Key key = std::move(data[i]);
+			std::size_t hole = i;
+			for (; hole > 0 && KeyTraits<Key>::less(key, data[hole - 1]); hole--) data[hole] = std::move(data[hole - 1]);
+			data[hole] = std::move(key);
+		}
+	}
+
+	// Sorts data on digit `byte` and the less significant ones. Keys are permuted into their buckets in
+	// place: the key at the head of an unfinished bucket is swapped straight to the next free slot of
+	// the bucket it belongs to, following the cycle until a key that belongs here comes back, so each
+	// key moves at most once per digit.
+	template<typename Key>
+	void americanFlagSortDigit(Key* data, std::size_t count, std::size_t byte)
+	{
+		using Traits = KeyTraits<Key>;
+
+		for (;;)
+		{
+			std::size_t counts[256] = {};
+			for (std::size_t i = 0; i < count; i++) counts[Traits::radixByte(data[i], byte)]++;
+
+			// A digit every key shares needs no permutation; move on to the next one without recursing.
+			if (counts[Traits::radixByte(data[0], byte)] == count)
+			{
+				if (byte == 0) return;
+				byte--;
+				continue;
+			}
+
+			std::size_t heads[256];
+			std::size_t tails[256];
+			std::size_t offset = 0;
+			for (int bucket = 0; bucket < 256; bucket++)
+			{
+				heads[bucket] = offset;
+				offset += counts[bucket];
+				tails[bucket] = offset;
+			}
+
+			for (int bucket = 0; bucket < 256; bucket++)
+			{
+				while (heads[bucket] < tails[bucket])
+				{
+					Key key = std::move(data[heads[bucket]]);
+					unsigned key_bucket = Traits::radixByte(key, byte);
+					while (key_bucket != static_cast<unsigned>(bucket))
+					{
+						std::swap(key, data[heads[key_bucket]++]);
+						key_bucket = Traits::radixByte(key, byte);
+					}
+					data[heads[bucket]++] = std::move(key);
+				}
+			}
+
+			if (byte == 0) return;
+
+			std::size_t first = 0;
+			for (int bucket = 0; bucket < 256; first += counts[bucket], bucket++)
+			{
+				if (counts[bucket] <= american_flag_insertion_threshold) insertionSortByKey(data + first, counts[bucket]);
+				else americanFlagSortDigit(data + first, counts[bucket], byte - 1);
+			}
+			return;
+		}
+	}
+
+	// In-place MSD radix sort on 8 bit digits in the order given by KeyTraits<Key>. Unlike radixSort it
+	// needs no buffer: the extra memory is two 256 entry offset tables per digit level on the stack.
+	// Not stable.
+	template<typename Key>
+	void americanFlagSort(Key* data, std::size_t count)
+	{
+		if (count <= american_flag_insertion_threshold) insertionSortByKey(data, count);
+		else americanFlagSortDigit(data, count, KeyTraits<Key>::radix_bytes - 1);
+	}
+}
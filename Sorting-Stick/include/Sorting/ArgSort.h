@@ -0,0 +1,95 @@
+#pragma once
+#include "Sorting/KeyTraits.h"
+#include "Sorting/MultiwayMergeSort.h"
+#include "Sorting/RadixSort.h"
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace Sorting
+{
+	// A 32 bit radix key in the high half and the element's index in the low half. The indices start
+	// out ascending and the LSD radix sort is stable, so only the four key bytes need scatter passes,
+	// and each pass moves one 8 byte word no matter how large the payload is.
+	struct PackedKeyIndex
+	{
+		std::uint64_t bits;
+	};
+
+	template<>
+	struct KeyTraits<PackedKeyIndex>
+	{
+		using RadixKey = std::uint32_t;
+		static constexpr bool has_radix_key = true;
+		static constexpr std::size_t radix_bytes = sizeof(RadixKey);
+
+		static bool less(const PackedKeyIndex& a, const PackedKeyIndex& b) { return a.bits < b.bits; }
+		static RadixKey toRadixKey(const PackedKeyIndex& packed) { return static_cast<RadixKey>(packed.bits >> 32); }
+		static unsigned radixByte(const PackedKeyIndex& packed, std::size_t byte) { return (toRadixKey(packed) >> (byte * 8)) & 0xFF; }
+	};
+
+	// Writes the stable sorting permutation of keys[0, count) to indices: keys[indices[i]] is the
+	// i-th smallest key. count must fit in 32 bits.
+	//   - 32 bit radix keys are packed with their index into one word and radix sorted on the key half
+	//   - wider radix keys are radix sorted as (key, index) records
+	//   - other keys sort the index array with a merge sort that compares through the keys
+	template<typename Key>
+	void argSort(const Key* keys, std::size_t count, std::uint32_t* indices)
+	{
+		using Traits = KeyTraits<Key>;
+
+		if constexpr (Traits::has_radix_key && Traits::radix_bytes == sizeof(std::uint32_t))
+		{
+			std::vector<PackedKeyIndex> packed(count);
+			for (std::size_t i = 0; i < count; i++) packed[i].bits = static_cast<std::uint64_t>(Traits::toRadixKey(keys[i])) << 32 | i;
+
+			radixSort(packed.data(), count);
+			for (std::size_t i = 0; i < count; i++) indices[i] = static_cast<std::uint32_t>(packed[i].bits);
+		}
+		else if constexpr (Traits::has_radix_key)
+		{
+			std::vector<KeyValue<Key, std::uint32_t>> records(count);
+			for (std::size_t i = 0; i < count; i++) records[i] = { keys[i], static_cast<std::uint32_t>(i) };
+
+			radixSort(records.data(), count);
+			for (std::size_t i = 0; i < count; i++) indices[i] = records[i].payload;
+		}
+		else
+		{
+			for (std::size_t i = 0; i < count; i++) indices[i] = static_cast<std::uint32_t>(i);
+			multiwayMergeSort(indices, count, 16, [keys](std::uint32_t a, std::uint32_t b) { return Traits::less(keys[a], keys[b]); });
+		}
+	}
+
+	template<typename Key>
+	std::vector<std::uint32_t> argSort(const Key* keys, std::size_t count)
+	{
+		std::vector<std::uint32_t> indices(count);
+		argSort(keys, count, indices.data());
+		return indices;
+	}
+
+	// destination[i] = source[indices[i]]; source and destination must not overlap.
+	template<typename Value>
+	void gather(const Value* source, const std::uint32_t* indices, std::size_t count, Value* destination)
+	{
+		for (std::size_t i = 0; i < count; i++) destination[i] = source[indices[i]];
+	}
+
+	// Stable sort of parallel key and payload arrays. The sort itself only moves packed keys and
+	// indices; every payload is moved exactly once, by the final gather.
+	template<typename Key, typename Payload>
+	void sortByKey(Key* keys, Payload* payloads, std::size_t count)
+	{
+		std::vector<std::uint32_t> indices = argSort(keys, count);
+
+		std::vector<Key> sorted_keys(count);
+		gather(keys, indices.data(), count, sorted_keys.data());
+		std::move(sorted_keys.begin(), sorted_keys.end(), keys);
+
+		std::vector<Payload> sorted_payloads(count);
+		gather(payloads, indices.data(), count, sorted_payloads.data());
+		std::move(sorted_payloads.begin(), sorted_payloads.end(), payloads);
+	}
+}
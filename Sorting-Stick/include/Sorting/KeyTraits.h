@@ -0,0 +1,111 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace Sorting
+{
+	// Byte string of a fixed length, ordered like memcmp.
+	template<std::size_t Length>
+	struct FixedString
+	{
+		unsigned char bytes[Length];
+	};
+
+	// Record ordered by its key alone; the payload travels with it.
+	template<typename Key, typename Payload>
+	struct KeyValue
+	{
+		Key key;
+		Payload payload;
+	};
+
+	// How the sorting kernels order and take apart one key type:
+	//   less(a, b)            strict weak order, a total order for floating point
+	//   radix_bytes           number of 8 bit digits radixByte can return
+	//   radixByte(key, i)     i-th digit with 0 the least significant, ordered consistently with less
+	// Types whose digits come from one unsigned integer also define RadixKey and toRadixKey, which
+	// the radix sort uses to convert each key once per pass instead of once per digit.
+	template<typename Key>
+	struct KeyTraits;
+
+	template<typename Integer, typename Unsigned>
+	struct IntegerKeyTraits
+	{
+		using RadixKey = Unsigned;
+		static constexpr bool has_radix_key = true;
+		static constexpr std::size_t radix_bytes = sizeof(Unsigned);
+
+		static bool less(Integer a, Integer b) { return a < b; }
+
+		// Flipping the sign bit maps two's complement order onto unsigned order.
+		static RadixKey toRadixKey(Integer key)
+		{
+			const Unsigned sign_bit = std::is_signed<Integer>::value ? Unsigned(1) << (sizeof(Unsigned) * 8 - 1) : 0;
+			return static_cast<Unsigned>(key) ^ sign_bit;
+		}
+
+		static unsigned radixByte(Integer key, std::size_t byte) { return static_cast<unsigned>(toRadixKey(key) >> (byte * 8)) & 0xFF; }
+	};
+
+	template<> struct KeyTraits<std::int32_t> : IntegerKeyTraits<std::int32_t, std::uint32_t> { };
+	template<> struct KeyTraits<std::int64_t> : IntegerKeyTraits<std::int64_t, std::uint64_t> { };
+	template<> struct KeyTraits<std::uint32_t> : IntegerKeyTraits<std::uint32_t, std::uint32_t> { };
+	template<> struct KeyTraits<std::uint64_t> : IntegerKeyTraits<std::uint64_t, std::uint64_t> { };
+
+	// IEEE 754 totalOrder: -NaN < -inf < ... < -0 < +0 < ... < +inf < +NaN. Negative values have all
+	// bits flipped and positive values only the sign bit, after which unsigned order is total order.
+	template<typename Float, typename Unsigned>
+	struct FloatKeyTraits
+	{
+		using RadixKey = Unsigned;
+		static constexpr bool has_radix_key = true;
+		static constexpr std::size_t radix_bytes = sizeof(Unsigned);
+
+		static RadixKey toRadixKey(Float key)
+		{
+			const Unsigned sign_bit = Unsigned(1) << (sizeof(Unsigned) * 8 - 1);
+
+			Unsigned bits;
+			std::memcpy(&bits, &key, sizeof(bits));
+			return (bits & sign_bit) ? ~bits : bits | sign_bit;
+		}
+
+		static bool less(Float a, Float b) { return toRadixKey(a) < toRadixKey(b); }
+		static unsigned radixByte(Float key, std::size_t byte) { return static_cast<unsigned>(toRadixKey(key) >> (byte * 8)) & 0xFF; }
+	};
+
+	template<> struct KeyTraits<float> : FloatKeyTraits<float, std::uint32_t> { };
+	template<> struct KeyTraits<double> : FloatKeyTraits<double, std::uint64_t> { };
+
+	template<std::size_t Length>
+	struct KeyTraits<FixedString<Length>>
+	{
+		using RadixKey = void; // digits come from radixByte only
+		static constexpr bool has_radix_key = false;
+		static constexpr std::size_t radix_bytes = Length;
+
+		static bool less(const FixedString<Length>& a, const FixedString<Length>& b) { return std::memcmp(a.bytes, b.bytes, Length) < 0; }
+		static unsigned radixByte(const FixedString<Length>& key, std::size_t byte) { return key.bytes[Length - 1 - byte]; }
+	};
+
+	template<typename Key, typename Payload>
+	struct KeyTraits<KeyValue<Key, Payload>>
+	{
+		using RadixKey = typename KeyTraits<Key>::RadixKey;
+		static constexpr bool has_radix_key = KeyTraits<Key>::has_radix_key;
+		static constexpr std::size_t radix_bytes = KeyTraits<Key>::radix_bytes;
+
+		static bool less(const KeyValue<Key, Payload>& a, const KeyValue<Key, Payload>& b) { return KeyTraits<Key>::less(a.key, b.key); }
+		static RadixKey toRadixKey(const KeyValue<Key, Payload>& record) { return KeyTraits<Key>::toRadixKey(record.key); }
+		static unsigned radixByte(const KeyValue<Key, Payload>& record, std::size_t byte) { return KeyTraits<Key>::radixByte(record.key, byte); }
+	};
+
+	// Comparator object for the kernels, resolved at compile time so it inlines to a plain compare.
+	template<typename Key>
+	struct KeyLess
+	{
+		bool operator()(const Key& a, const Key& b) const { return KeyTraits<Key>::less(a, b); }
+	};
+}
@@ -0,0 +1,100 @@
+#pragma once
+#include "Sorting/KeyTraits.h"
+#include <cstddef>
+#include <vector>
+
+namespace Sorting
+{
+	// Tournament tree over k sorted sources. Every internal node keeps the loser of the match played
+	// there and the overall winner sits above the root, so when the winner's source moves on only the
+	// log2(k) matches on its leaf-to-root path are replayed, each against one stored loser. The replay
+	// picks winner and loser with conditional moves rather than branches.
+	//
+	// Ties go to the lower source index, so merging runs in their original order is stable.
+	template<typename Key, typename Less = KeyLess<Key>>
+	class LoserTree
+	{
+	private:
+		std::size_t leaf_count;
+		std::vector<std::size_t> losers; // losers[0] holds the winner, losers[1 .. leaf_count - 1] the internal nodes
+		std::vector<Key> keys;
+		std::vector<unsigned char> exhausted;
+		Less less;
+
+		// Exhausted sources (and the padding up to a power of two) never win; less is only called on live keys.
+		bool beats(std::size_t a, std::size_t b) const
+		{
+			if (exhausted[a] || exhausted[b]) return !exhausted[a];
+			return a < b ? !less(keys[b], keys[a]) : less(keys[a], keys[b]);
+		}
+
+		void replay(std::size_t source)
+		{
+			std::size_t winner = source;
+			for (std::size_t node = (leaf_count + source) >> 1; node > 0; node >>= 1)
+			{
+				std::size_t loser = losers[node];
+				bool loser_wins = beats(loser, winner);
+				losers[node] = loser_wins ? winner : loser;
+				winner = loser_wins ? loser : winner;
+			}
+			losers[0] = winner;
+		}
+
+	public:
+		explicit LoserTree(std::size_t source_count, Less less = Less()) : less(less)
+		{
+			leaf_count = 1;
+			while (leaf_count < source_count) leaf_count <<= 1;
+
+			losers.assign(leaf_count, 0);
+			keys.resize(leaf_count);
+			exhausted.assign(leaf_count, 1);
+		}
+
+		// Sources that are never given a key count as empty.
+		void setSource(std::size_t source, const Key& key)
+		{
+			keys[source] = key;
+			exhausted[source] = 0;
+		}
+
+		// Plays the initial tournament bottom-up once every source has its first key.
+		void build()
+		{
+			std::vector<std::size_t> winners(2 * leaf_count);
+			for (std::size_t source = 0; source < leaf_count; source++) winners[leaf_count + source] = source;
+
+			for (std::size_t node = leaf_count - 1; node > 0; node--)
+			{
+				std::size_t left = winners[2 * node];
+				std::size_t right = winners[2 * node + 1];
+				bool left_wins = beats(left, right);
+
+				winners[node] = left_wins ? left : right;
+				losers[node] = left_wins ? right : left;
+			}
+			losers[0] = winners[1];
+		}
+
+		bool empty() const { return exhausted[losers[0]] != 0; }
+		std::size_t winner() const { return losers[0]; }
+		const Key& winnerKey() const { return keys[losers[0]]; }
+
+		// The winner's source produced its next key.
+		void replaceWinner(const Key& key)
+		{
+			std::size_t source = losers[0];
+			keys[source] = key;
+			replay(source);
+		}
+
+		// The winner's source has run out.
+		void removeWinner()
+		{
+			std::size_t source = losers[0];
+			exhausted[source] = 1;
+			replay(source);
+		}
+	};
+}
@@ -0,0 +1,76 @@
+#pragma once
+#include "Sorting/LoserTree.h"
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace Sorting
+{
+	// Runs shorter than this are insertion sorted before the first merge pass.
+	const std::size_t multiway_base_run_length = 16;
+
+	// Merges the sorted runs source[run_bounds[r], run_bounds[r + 1]) for r < run_count into destination.
+	template<typename Key, typename Less = KeyLess<Key>>
+	void multiwayMerge(const Key* source, const std::size_t* run_bounds, std::size_t run_count, Key* destination, Less less = Less())
+	{
+		LoserTree<Key, Less> tree(run_count, less);
+		std::vector<std::size_t> positions(run_bounds, run_bounds + run_count);
+
+		for (std::size_t run = 0; run < run_count; run++) if (run_bounds[run] < run_bounds[run + 1]) tree.setSource(run, source[run_bounds[run]]);
+		tree.build();
+
+		while (!tree.empty())
+		{
+			std::size_t run = tree.winner();
+			*destination++ = tree.winnerKey();
+
+			if (++positions[run] < run_bounds[run + 1]) tree.replaceWinner(source[positions[run]]);
+			else tree.removeWinner();
+		}
+	}
+
+	// Bottom-up stable merge sort that merges `ways` runs at a time, so the data is streamed through
+	// memory ceil(log_ways(n / base run)) times instead of ceil(log2(n / base run)) times.
+	// Returns the number of merge passes.
+	template<typename Key, typename Less = KeyLess<Key>>
+	int multiwayMergeSort(Key* data, std::size_t count, std::size_t ways, Less less = Less())
+	{
+		ways = std::max<std::size_t>(ways, 2);
+
+		for (std::size_t first = 0; first < count; first += multiway_base_run_length)
+		{
+			Key* run_end = data + std::min(count, first + multiway_base_run_length);
+			for (Key* position = data + first + 1; position < run_end; position++)
+			{
+				Key key = std::move(*position);
+				Key* hole = position;
+				for (; hole > data + first && less(key, hole[-1]); hole--) *hole = std::move(hole[-1]);
+				*hole = std::move(key);
+			}
+		}
+
+		std::vector<Key> buffer(count);
+		Key* from = data;
+		Key* to = buffer.data();
+		std::vector<std::size_t> run_bounds(ways + 1);
+		int passes = 0;
+
+		for (std::size_t run_length = multiway_base_run_length; run_length < count; run_length *= ways)
+		{
+			for (std::size_t first = 0; first < count; first += run_length * ways)
+			{
+				std::size_t run_count = 0;
+				for (std::size_t bound = first; bound < count && run_count < ways; bound += run_length) run_bounds[run_count++] = bound;
+				run_bounds[run_count] = std::min(count, first + run_length * ways);
+
+				multiwayMerge(from, run_bounds.data(), run_count, to + first, less);
+			}
+
+			std::swap(from, to);
+			passes++;
+		}
+
+		if (from != data) std::move(from, from + count, data);
+		return passes;
+	}
+}
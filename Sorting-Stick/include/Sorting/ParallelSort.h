@@ -0,0 +1,96 @@
+#pragma once
+#include "Sorting/KeyTraits.h"
+#include "Threading/NumaMemory.h"
+#include "Threading/TaskScheduler.h"
+#include <algorithm>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+namespace Sorting
+{
+	// Ranges up to this size are sorted by one task with std::stable_sort.
+	const std::size_t parallel_sort_leaf_size = 1 << 14;
+
+	// Merges with at most this many outputs are not split any further.
+	const std::size_t parallel_merge_leaf_size = 1 << 13;
+
+	// Stable merge of a and b into destination, split into independent halves until they are small.
+	// The split key comes from the longer input and the other input is cut with a binary search,
+	// lower_bound in b or upper_bound in a, so keys equal to it keep a before b.
+	template<typename Key, typename Less = KeyLess<Key>>
+	void parallelMerge(const Key* a, std::size_t a_count, const Key* b, std::size_t b_count, Key* destination, Less less = Less())
+	{
+		if (a_count + b_count <= parallel_merge_leaf_size)
+		{
+			std::merge(a, a + a_count, b, b + b_count, destination, less);
+			return;
+		}
+
+		std::size_t a_split;
+		std::size_t b_split;
+		if (a_count >= b_count)
+		{
+			a_split = a_count / 2;
+			b_split = std::lower_bound(b, b + b_count, a[a_split], less) - b;
+		}
+		else
+		{
+			b_split = b_count / 2;
+			a_split = std::upper_bound(a, a + a_count, b[b_split], less) - a;
+		}
+
+		Threading::TaskGroup merge_group;
+		merge_group.run([=]() { parallelMerge(a, a_split, b, b_split, destination, less); });
+		parallelMerge(a + a_split, a_count - a_split, b + b_split, b_count - b_split, destination + a_split + b_split, less);
+		merge_group.wait();
+	}
+
+	// Sorts data[0, count) into data, or into buffer when to_buffer is set; the other array is scratch.
+	// The halves are sorted into the opposite array so every level merges without copying back.
+	template<typename Key, typename Less>
+	void parallelMergeSortRange(Key* data, Key* buffer, std::size_t count, bool to_buffer, Less less)
+	{
+		if (count <= parallel_sort_leaf_size)
+		{
+			std::stable_sort(data, data + count, less);
+			if (to_buffer) std::copy(data, data + count, buffer);
+			return;
+		}
+
+		std::size_t half = count / 2;
+		Threading::TaskGroup sort_group;
+		sort_group.run([=]() { parallelMergeSortRange(data, buffer, half, !to_buffer, less); });
+		parallelMergeSortRange(data + half, buffer + half, count - half, !to_buffer, less);
+		sort_group.wait();
+
+		if (to_buffer) parallelMerge(data, half, data + half, count - half, buffer, less);
+		else parallelMerge(buffer, half, buffer + half, count - half, data, less);
+	}
+
+	// Stable fork/join merge sort on the shared worker pool. Both the sorts and the merges are split,
+	// so the last merges are not left to one thread; uses one buffer of count keys. For trivial keys the
+	// buffer is left untouched, so each page is first written, and placed, by the task that sorts that range.
+	template<typename Key, typename Less = KeyLess<Key>>
+	void parallelMergeSort(Key* data, std::size_t count, Less less = Less())
+	{
+		if (count <= parallel_sort_leaf_size)
+		{
+			std::stable_sort(data, data + count, less);
+			return;
+		}
+
+		if constexpr (std::is_trivial<Key>::value)
+		{
+			Threading::NumaBuffer<Key> buffer(count);
+			if (!buffer.empty())
+			{
+				parallelMergeSortRange(data, buffer.data(), count, false, less);
+				return;
+			}
+		}
+
+		std::vector<Key> buffer(count);
+		parallelMergeSortRange(data, buffer.data(), count, false, less);
+	}
+}
@@ -0,0 +1,120 @@
+#pragma once
+#include "Sorting/KeyTraits.h"
+#include "Threading/NumaMemory.h"
+#include <algorithm>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Sorting
+{
+	// Scatter passes over at least this many keys stage them a cache line per bucket before writing.
+	const std::size_t radix_write_combining_threshold = 1 << 16;
+	const std::size_t radix_staging_line_bytes = 64;
+
+	// Scatter through one staged cache line per bucket, written out whole. The 256 output streams then
+	// cost one store burst per line instead of one scattered store per key, and regular bucket sizes
+	// no longer make every stream hit the same cache sets, which happens on huge pages where the
+	// buffer is physically contiguous. Stable: every bucket keeps its keys in input order.
+	template<typename Key, typename BucketOf>
+	void scatterWriteCombined(Key* from, Key* to, std::size_t count, std::size_t* offsets, Key* staging, BucketOf bucket_of)
+	{
+		const std::size_t line_keys = radix_staging_line_bytes / sizeof(Key);
+		std::size_t staged[256] = {};
+
+		for (std::size_t i = 0; i < count; i++)
+		{
+			std::size_t bucket = bucket_of(from[i]);
+			Key* line = staging + bucket * line_keys;
+			line[staged[bucket]++] = std::move(from[i]);
+
+			if (staged[bucket] < line_keys) continue;
+			std::move(line, line + line_keys, to + offsets[bucket]);
+			offsets[bucket] += line_keys;
+			staged[bucket] = 0;
+		}
+
+		for (std::size_t bucket = 0; bucket < 256; bucket++)
+		{
+			std::move(staging + bucket * line_keys, staging + bucket * line_keys + staged[bucket], to + offsets[bucket]);
+			offsets[bucket] += staged[bucket];
+		}
+	}
+
+	// Stable LSD radix sort on 8 bit digits in the order given by KeyTraits<Key>. All digit histograms
+	// are counted in one pass over the data, and digits on which every key agrees are skipped, so
+	// narrow key ranges cost fewer scatter passes than the key width suggests.
+	// Returns the number of scatter passes.
+	template<typename Key>
+	int radixSort(Key* data, std::size_t count)
+	{
+		using Traits = KeyTraits<Key>;
+		const std::size_t digits = Traits::radix_bytes;
+
+		std::vector<std::size_t> histograms(digits * 256, 0);
+
+		// Types backed by one unsigned integer are converted once per key and shifted, instead of
+		// going through radixByte for every digit.
+		if constexpr (Traits::has_radix_key)
+		{
+			for (std::size_t i = 0; i < count; i++)
+			{
+				typename Traits::RadixKey radix_key = Traits::toRadixKey(data[i]);
+				for (std::size_t digit = 0; digit < digits; digit++) histograms[digit * 256 + ((radix_key >> (digit * 8)) & 0xFF)]++;
+			}
+		}
+		else
+		{
+			for (std::size_t i = 0; i < count; i++)
+				for (std::size_t digit = 0; digit < digits; digit++) histograms[digit * 256 + Traits::radixByte(data[i], digit)]++;
+		}
+
+		// Trivial keys get their scratch buffer from the huge page arena: the scatter passes write to 256
+		// places at once, and with 4 KiB pages over a large array nearly every one of them is a TLB miss.
+		Threading::NumaBuffer<std::conditional_t<std::is_trivial<Key>::value, Key, char>> arena_buffer;
+		std::vector<Key> buffer;
+		Key* to = nullptr;
+		if constexpr (std::is_trivial<Key>::value)
+		{
+			arena_buffer.allocate(count);
+			to = arena_buffer.data();
+		}
+		if (!to)
+		{
+			buffer.resize(count);
+			to = buffer.data();
+		}
+
+		// Only worth it while a line holds several keys.
+		bool write_combining = sizeof(Key) * 4 <= radix_staging_line_bytes && count >= radix_write_combining_threshold;
+		std::vector<Key> staging(write_combining ? 256 * (radix_staging_line_bytes / sizeof(Key)) : 0);
+
+		Key* from = data;
+		int passes = 0;
+
+		for (std::size_t digit = 0; digit < digits; digit++)
+		{
+			std::size_t* offsets = histograms.data() + digit * 256;
+			if (count == 0 || std::find(offsets, offsets + 256, count) != offsets + 256) continue;
+
+			std::size_t total = 0;
+			for (int bucket = 0; bucket < 256; bucket++) total += std::exchange(offsets[bucket], total);
+
+			auto bucket_of = [digit](const Key& key) -> std::size_t
+				{
+					if constexpr (Traits::has_radix_key) return (Traits::toRadixKey(key) >> (digit * 8)) & 0xFF;
+					else return Traits::radixByte(key, digit);
+				};
+
+			if (write_combining) scatterWriteCombined(from, to, count, offsets, staging.data(), bucket_of);
+			else for (std::size_t i = 0; i < count; i++) to[offsets[bucket_of(from[i])]++] = std::move(from[i]);
+
+			std::swap(from, to);
+			passes++;
+		}
+
+		if (from != data) std::move(from, from + count, data);
+		return passes;
+	}
+}
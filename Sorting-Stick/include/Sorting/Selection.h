@@ -0,0 +1,138 @@
+#pragma once
+#include "Sorting/KeyTraits.h"
+#include "Threading/TaskScheduler.h"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace Sorting
+{
+	// Ranges longer than this pick their partitioning element from a recursively selected sample.
+	const std::ptrdiff_t floyd_rivest_sample_threshold = 600;
+
+	// Top k splits the input over the worker threads once every thread gets at least this many keys.
+	const std::size_t min_top_k_values_per_thread = 1 << 16;
+
+	// Floyd-Rivest selection on data[left, right]: picks a pivot from a small sample chosen so the k-th
+	// key very likely falls between two sample keys, which makes the expected comparison count
+	// n + min(k, n - k) + o(n) instead of the ~3.4n of quickselect with a random pivot.
+	template<typename Key, typename Less>
+	void floydRivestSelect(Key* data, std::ptrdiff_t left, std::ptrdiff_t right, std::ptrdiff_t k, Less& less)
+	{
+		while (right > left)
+		{
+			if (right - left > floyd_rivest_sample_threshold)
+			{
+				double n = static_cast<double>(right - left + 1);
+				double i = static_cast<double>(k - left + 1);
+				double z = std::log(n);
+				double s = 0.5 * std::exp(2.0 * z / 3.0);
+				double sd = 0.5 * std::sqrt(z * s * (n - s) / n) * (i < n / 2 ? -1.0 : 1.0);
+				std::ptrdiff_t sample_left = std::max(left, static_cast<std::ptrdiff_t>(k - i * s / n + sd));
+				std::ptrdiff_t sample_right = std::min(right, static_cast<std::ptrdiff_t>(k + (n - i) * s / n + sd));
+				floydRivestSelect(data, sample_left, sample_right, k, less);
+			}
+
+			Key pivot = data[k];
+			std::ptrdiff_t i = left;
+			std::ptrdiff_t j = right;
+
+			std::swap(data[left], data[k]);
+			if (less(pivot, data[right])) std::swap(data[right], data[left]);
+
+			while (i < j)
+			{
+				std::swap(data[i], data[j]);
+				i++;
+				j--;
+				while (less(data[i], pivot)) i++;
+				while (less(pivot, data[j])) j--;
+			}
+
+			if (!less(data[left], pivot) && !less(pivot, data[left])) std::swap(data[left], data[j]);
+			else
+			{
+				j++;
+				std::swap(data[j], data[right]);
+			}
+
+			if (j <= k) left = j + 1;
+			if (k <= j) right = j - 1;
+		}
+	}
+
+	// Reorders data so data[nth] is the key a full sort would put there, nothing before it is greater
+	// and nothing after it is less.
+	template<typename Key, typename Less = KeyLess<Key>>
+	void nthElement(Key* data, std::size_t count, std::size_t nth, Less less = Less())
+	{
+		if (nth >= count) return;
+		floydRivestSelect(data, 0, static_cast<std::ptrdiff_t>(count) - 1, static_cast<std::ptrdiff_t>(nth), less);
+	}
+
+	// Puts the k smallest keys in sorted order at the front; the rest are left in unspecified order.
+	// Selecting first costs O(n), so only the k keys pay the O(k log k) of sorting.
+	template<typename Key, typename Less = KeyLess<Key>>
+	void partialSort(Key* data, std::size_t count, std::size_t k, Less less = Less())
+	{
+		k = std::min(k, count);
+		if (k == 0) return;
+
+		if (k < count) nthElement(data, count, k - 1, less);
+		std::sort(data, data + k, less);
+	}
+
+	// Writes the k largest keys of data to top, largest first. Every thread keeps a min-heap of the
+	// k largest keys of its slice, so a key that cannot make the cut costs one comparison; the
+	// per-thread candidates are then reduced with one selection.
+	template<typename Key, typename Less = KeyLess<Key>>
+	void topK(const Key* data, std::size_t count, std::size_t k, Key* top, Less less = Less())
+	{
+		k = std::min(k, count);
+		if (k == 0) return;
+
+		std::size_t worker_threads = Threading::TaskScheduler::getInstance()->getThreadCount();
+		std::size_t thread_count = std::max<std::size_t>(1, std::min(worker_threads, count / std::max(k, min_top_k_values_per_thread)));
+		std::size_t chunk_size = (count + thread_count - 1) / thread_count;
+
+		auto greater = [&less](const Key& a, const Key& b) { return less(b, a); };
+		std::vector<std::vector<Key>> heaps(thread_count);
+
+		auto select_chunk = [&](std::size_t chunk)
+			{
+				std::vector<Key>& heap = heaps[chunk];
+				const Key* first = data + chunk * chunk_size;
+				const Key* last = data + std::min(count, (chunk + 1) * chunk_size);
+
+				heap.reserve(k);
+				for (const Key* key = first; key < last; key++)
+				{
+					if (heap.size() < k)
+					{
+						heap.push_back(*key);
+						std::push_heap(heap.begin(), heap.end(), greater);
+					}
+					else if (less(heap.front(), *key))
+					{
+						std::pop_heap(heap.begin(), heap.end(), greater);
+						heap.back() = *key;
+						std::push_heap(heap.begin(), heap.end(), greater);
+					}
+				}
+			};
+
+		Threading::TaskGroup select_group;
+		for (std::size_t chunk = 1; chunk < thread_count; chunk++) select_group.run([&select_chunk, chunk]() { select_chunk(chunk); });
+		select_chunk(0);
+		select_group.wait();
+
+		std::vector<Key> candidates;
+		candidates.reserve(thread_count * k);
+		for (const std::vector<Key>& heap : heaps) candidates.insert(candidates.end(), heap.begin(), heap.end());
+
+		partialSort(candidates.data(), candidates.size(), k, greater);
+		std::copy(candidates.begin(), candidates.begin() + k, top);
+	}
+}
@@ -0,0 +1,42 @@
+#pragma once
+#include <cstddef>
+
+namespace Sorting
+{
+	enum class StabilityCheck
+	{
+		NOT_CHECKED,
+		STABLE,
+		UNSTABLE,
+		NOT_SORTED,
+		PARTITIONED, // nth element: only the partition around one position is defined
+	};
+
+	inline const char* getStabilityCheckName(StabilityCheck check)
+	{
+		switch (check)
+		{
+		case StabilityCheck::STABLE: return "Stable";
+		case StabilityCheck::UNSTABLE: return "Unstable";
+		case StabilityCheck::NOT_SORTED: return "Not Sorted";
+		case StabilityCheck::PARTITIONED: return "Partitioned";
+		default: return "-";
+		}
+	}
+
+	// Checks a sorted sequence whose values carry the index they had in the input: it is sorted if no
+	// value is less than its predecessor, and stable if equal neighbours kept their input order.
+	// One pass over adjacent pairs, no allocation.
+	template<typename Value, typename Less, typename IndexOf>
+	StabilityCheck checkStableOrder(const Value* values, std::size_t count, Less less, IndexOf index_of)
+	{
+		StabilityCheck result = StabilityCheck::STABLE;
+
+		for (std::size_t i = 1; i < count; i++)
+		{
+			if (less(values[i], values[i - 1])) return StabilityCheck::NOT_SORTED;
+			if (index_of(values[i]) < index_of(values[i - 1]) && !less(values[i - 1], values[i])) result = StabilityCheck::UNSTABLE;
+		}
+		return result;
+	}
+}
@@ -0,0 +1,99 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+
+namespace Sound
+{
+	// Bounded lock-free multi-producer queue (Vyukov's sequence-numbered ring).
+	// push() never blocks or allocates: when the ring is full the item is dropped and false is returned,
+	// which is what we want for sound requests that are coalesced per frame anyway.
+	template<typename T, std::size_t Capacity>
+	class LockFreeQueue
+	{
+		static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+	private:
+		struct Cell
+		{
+			std::atomic<std::size_t> sequence;
+			T data;
+		};
+
+		static constexpr std::size_t cache_line_size = 64;
+
+		Cell cells[Capacity];
+		alignas(cache_line_size) std::atomic<std::size_t> enqueue_position;
+		alignas(cache_line_size) std::atomic<std::size_t> dequeue_position;
+
+	public:
+		LockFreeQueue()
+		{
+			for (std::size_t i = 0; i < Capacity; i++) cells[i].sequence.store(i, std::memory_order_relaxed);
+			enqueue_position.store(0, std::memory_order_relaxed);
+			dequeue_position.store(0, std::memory_order_relaxed);
+		}
+
+		LockFreeQueue(const LockFreeQueue&) = delete;
+		LockFreeQueue& operator=(const LockFreeQueue&) = delete;
+
+		bool push(const T& item)
+		{
+			std::size_t position = enqueue_position.load(std::memory_order_relaxed);
+
+			while (true)
+			{
+				Cell& cell = cells[position & (Capacity - 1)];
+				std::size_t sequence = cell.sequence.load(std::memory_order_acquire);
+				std::ptrdiff_t difference = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position);
+
+				if (difference == 0)
+				{
+					if (enqueue_position.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+					{
+						cell.data = item;
+						cell.sequence.store(position + 1, std::memory_order_release);
+						return true;
+					}
+				}
+				else if (difference < 0)
+				{
+					return false;
+				}
+				else
+				{
+					position = enqueue_position.load(std::memory_order_relaxed);
+				}
+			}
+		}
+
+		bool pop(T& item)
+		{
+			std::size_t position = dequeue_position.load(std::memory_order_relaxed);
+
+			while (true)
+			{
+				Cell& cell = cells[position & (Capacity - 1)];
+				std::size_t sequence = cell.sequence.load(std::memory_order_acquire);
+				std::ptrdiff_t difference = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position + 1);
+
+				if (difference == 0)
+				{
+					if (dequeue_position.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+					{
+						item = cell.data;
+						cell.sequence.store(position + Capacity, std::memory_order_release);
+						return true;
+					}
+				}
+				else if (difference < 0)
+				{
+					return false;
+				}
+				else
+				{
+					position = dequeue_position.load(std::memory_order_relaxed);
+				}
+			}
+		}
+	};
+}
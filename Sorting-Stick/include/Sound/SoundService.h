@@ -1,5 +1,8 @@
 #pragma once
 #include "SFML/Audio.hpp"
+#include "Sound/LockFreeQueue.h"
+#include "Sound/ToneSynthesizer.h"
+#include <atomic>
 
 namespace Sound
 {
@@ -12,21 +15,42 @@ namespace Sound
 	class SoundService
 	{
 	private:
+		static const int sound_type_count = 2;
+		static const int voice_count = 8;
+		static const std::size_t sound_command_capacity = 1024;
+
 		const int background_music_volume = 30;
 		const int sound_effect_volume = 200;
+		const int max_sound_starts_per_frame = 2;
 
 		sf::Music background_music;
-		sf::Sound sound_effect;
-		sf::SoundBuffer buffer_button_click;
-		sf::SoundBuffer buffer_compare_sfx;
+		sf::Sound voices[voice_count];
+		sf::SoundBuffer* buffer_button_click = nullptr;
+		sf::SoundBuffer* buffer_compare_sfx = nullptr;
+
+		// Requests from any thread (the sort thread plays a sound on every comparison);
+		// drained and coalesced once per frame on the main thread.
+		LockFreeQueue<SoundType, sound_command_capacity> sound_commands;
+
+		// Sonification mode (toggled with F4): comparisons play a tone pitched by the compared value
+		// instead of the compare_sfx clip. Toggled on the main thread, read by every sort thread.
+		ToneSynthesizer tone_synthesizer;
+		std::atomic<bool> sonification_enabled{ false };
 
 		void loadBackgroundMusicFromFile();
 		void loadSoundFromFile();
 
+		sf::SoundBuffer* getSoundBuffer(SoundType sound_type);
+		sf::Sound* acquireVoice();
+		void startSound(SoundType sound_type);
+		void toggleSonification();
+
 	public:
 		void initialize();
+		void update();
 
 		void playSound(SoundType soundType);
+		void playCompareSound(int value, int max_value);
 		void playBackgroundMusic();
 	};
-}
\ No newline at end of file
+}
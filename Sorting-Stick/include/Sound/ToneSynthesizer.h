@@ -0,0 +1,58 @@
+#pragma once
+#include <SFML/Audio/SoundStream.hpp>
+#include "Sound/LockFreeQueue.h"
+
+namespace Sound
+{
+	// Streams short sine tones whose pitch follows a normalized value (0 = lowest, 1 = highest).
+	// Tones are requested from any thread through a lock-free queue and mixed on SFML's audio
+	// thread in onGetData(), which never allocates. When more tones arrive than can be voiced,
+	// events are downsampled evenly and the oldest voices are stolen.
+	class ToneSynthesizer : public sf::SoundStream
+	{
+	private:
+		struct Voice
+		{
+			bool active = false;
+			double phase = 0.0;
+			double phase_increment = 0.0;
+			int elapsed_samples = 0;
+		};
+
+		static const unsigned int sample_rate = 44100;
+		static const int chunk_sample_count = 512;
+		static const int voice_count = 16;
+		static const int max_new_voices_per_chunk = 8;
+		static const std::size_t tone_queue_capacity = 8192;
+
+		const float lowest_frequency = 220.f;
+		const float octave_range = 3.f;
+		const int tone_duration_samples = sample_rate * 70 / 1000;
+		const int attack_samples = sample_rate * 3 / 1000;
+		const float voice_amplitude = 0.18f;
+
+		LockFreeQueue<float, tone_queue_capacity> tone_events;
+
+		Voice voices[voice_count];
+		sf::Int16 sample_buffer[chunk_sample_count];
+		int events_in_last_chunk;
+
+		void startVoice(float normalized_value);
+		Voice* acquireVoice();
+		void consumeToneEvents();
+		float getEnvelope(int elapsed_samples);
+
+	protected:
+		bool onGetData(Chunk& data) override;
+		void onSeek(sf::Time time_offset) override;
+
+	public:
+		ToneSynthesizer();
+		~ToneSynthesizer();
+
+		// Safe to call from any thread; dropped when the queue is full.
+		void queueTone(float normalized_value);
+		// Drops queued tones. Only while stopped: the audio thread is the queue's single consumer.
+		void clearToneEvents();
+	};
+}
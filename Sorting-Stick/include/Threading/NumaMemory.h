@@ -0,0 +1,116 @@
+#pragma once
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Threading
+{
+	enum class NumaPolicy
+	{
+		OFF,			// buffers are zeroed by the allocating thread, so all their pages land on its node
+		FIRST_TOUCH,	// pages stay untouched until the thread that processes them writes them first
+		INTERLEAVE,		// pages are spread round robin over all nodes (needs libnuma)
+	};
+
+	// NUMA topology, thread pinning and page placement for the large sort buffers. On Linux the topology
+	// and the interleave policy come from libnuma, loaded at run time so machines without it simply
+	// run with one node; on Windows they come from kernel32, which has no interleave policy.
+	class NumaMemory
+	{
+	private:
+		static NumaPolicy policy;
+		static bool thread_pinning;
+		static bool initialized;
+		static int node_count;
+		static std::vector<int> pinning_cpus;
+
+		static void loadTopology();
+
+	public:
+		// Reads --numa and --pin-threads; call before the task scheduler starts so its workers get pinned.
+		static void initializeFromCommandLine();
+		static void initialize(NumaPolicy policy, bool thread_pinning);
+
+		static bool parsePolicy(const char* name, NumaPolicy& policy);
+		static const char* getPolicyName(NumaPolicy policy);
+
+		static NumaPolicy getPolicy();
+		// Switches the placement of later allocations, used by the benchmark to compare the policies.
+		static void setPolicy(NumaPolicy policy);
+		static bool isThreadPinningEnabled();
+		static bool isNumaLibraryAvailable();
+		static int getNodeCount();
+
+		// Pins the calling thread to one allowed CPU. Consecutive workers alternate between nodes so a
+		// partly used pool still draws on the memory bandwidth of every socket. Returns the CPU or -1.
+		static int pinCurrentThread(int worker_index);
+
+		// Page aligned memory from the huge page arena, not touched here unless the policy is OFF; free
+		// with deallocate. Only freshly mapped blocks are placed by their first writer or interleaved: a
+		// block the arena hands out again keeps the placement from its previous use.
+		static void* allocate(std::size_t bytes);
+		static void deallocate(void* memory);
+
+		// Counts the resident pages of [memory, memory + bytes) on every node, sampling large ranges.
+		// Returns false when the placement cannot be queried.
+		static bool countPagesPerNode(const void* memory, std::size_t bytes, std::vector<std::size_t>& pages_per_node);
+	};
+
+	// Array of trivial values placed by NumaMemory. Unlike std::vector it leaves the values
+	// uninitialized, so the first thread to write a page decides which node it lives on.
+	template<typename T>
+	class NumaBuffer
+	{
+		static_assert(std::is_trivial<T>::value, "NumaBuffer leaves its values uninitialized");
+
+	private:
+		T* values;
+		std::size_t count;
+
+	public:
+		NumaBuffer() : values(nullptr), count(0) { }
+		explicit NumaBuffer(std::size_t count) : values(nullptr), count(0) { allocate(count); }
+		~NumaBuffer() { release(); }
+
+		NumaBuffer(const NumaBuffer&) = delete;
+		NumaBuffer& operator=(const NumaBuffer&) = delete;
+
+		NumaBuffer(NumaBuffer&& other) noexcept : values(other.values), count(other.count)
+		{
+			other.values = nullptr;
+			other.count = 0;
+		}
+
+		NumaBuffer& operator=(NumaBuffer&& other) noexcept
+		{
+			std::swap(values, other.values);
+			std::swap(count, other.count);
+			return *this;
+		}
+
+		void allocate(std::size_t new_count)
+		{
+			release();
+			if (new_count == 0) return;
+
+			values = static_cast<T*>(NumaMemory::allocate(new_count * sizeof(T)));
+			count = values ? new_count : 0;
+		}
+
+		void release()
+		{
+			if (values) NumaMemory::deallocate(values);
+			values = nullptr;
+			count = 0;
+		}
+
+		T* data() { return values; }
+		const T* data() const { return values; }
+		std::size_t size() const { return count; }
+		bool empty() const { return count == 0; }
+
+		T& operator[](std::size_t index) { return values[index]; }
+		const T& operator[](std::size_t index) const { return values[index]; }
+	};
+}
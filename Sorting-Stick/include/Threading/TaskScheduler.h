@@ -0,0 +1,117 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Threading
+{
+	struct TaskSchedulerStats
+	{
+		int thread_count;
+		std::uint64_t tasks_executed;
+		std::uint64_t tasks_stolen;
+		float utilization; // share of worker time spent running tasks since the previous getStats()
+	};
+
+	// Process wide pool of worker threads. Each worker owns a deque: it pushes and pops its own tasks
+	// at the back, so forked work stays hot in its cache, and idle workers steal from the front of
+	// the others. Tasks submitted from outside the pool are dealt round robin over the workers.
+	//
+	// Tasks must not block on work that is still queued: waiting through TaskGroup::wait() runs
+	// pending tasks instead of sleeping, but a future from async() must only be waited on outside
+	// the pool. Paced work that sleeps, like the animated sorts, keeps its own thread.
+	class TaskScheduler
+	{
+	private:
+		struct Worker
+		{
+			std::mutex deque_mutex;
+			std::deque<std::function<void()>> tasks;
+			std::thread thread;
+
+			std::atomic<std::uint64_t> busy_nanoseconds{ 0 };
+			std::atomic<std::uint64_t> tasks_executed{ 0 };
+			std::atomic<std::uint64_t> tasks_stolen{ 0 };
+		};
+
+		std::vector<std::unique_ptr<Worker>> workers;
+		std::once_flag start_flag;
+		std::atomic<bool> stopping;
+		std::atomic<int> queued_tasks;
+		std::atomic<unsigned> next_submit_worker;
+
+		std::mutex sleep_mutex;
+		std::condition_variable wake_condition;
+
+		std::mutex stats_mutex;
+		std::chrono::steady_clock::time_point stats_time;
+		std::uint64_t stats_busy_nanoseconds;
+
+		static thread_local int current_worker_index;
+		static thread_local const TaskScheduler* current_scheduler;
+
+		TaskScheduler();
+		~TaskScheduler();
+
+		void start(int thread_count);
+		void runWorker(int worker_index);
+		bool popTask(int worker_index, std::function<void()>& task);
+		bool stealTask(int thief_index, std::function<void()>& task);
+		void executeTask(int worker_index, std::function<void()>& task);
+
+	public:
+		static TaskScheduler* getInstance();
+
+		// Starts the workers; 0 uses one per hardware thread. Only the first call has an effect, and
+		// submitting work before any call starts the default number of workers.
+		void initialize(int thread_count);
+		void destroy();
+
+		int getThreadCount();
+		TaskSchedulerStats getStats();
+
+		void submit(std::function<void()> task);
+
+		// Runs one queued task on the calling thread, so a thread waiting for forked work helps with it.
+		bool runPendingTask();
+
+		template<typename Function>
+		auto async(Function function) -> std::future<decltype(function())>
+		{
+			using Result = decltype(function());
+			std::shared_ptr<std::packaged_task<Result()>> task = std::make_shared<std::packaged_task<Result()>>(std::move(function));
+			std::future<Result> result = task->get_future();
+			submit([task]() { (*task)(); });
+			return result;
+		}
+
+		// Calls body(first_index, last_index) on chunks of [first, last) of at least min_chunk_size
+		// indices, spread over the workers and the calling thread; returns when every chunk is done.
+		void parallelFor(std::size_t first, std::size_t last, std::size_t min_chunk_size, const std::function<void(std::size_t, std::size_t)>& body);
+	};
+
+	// Fork/join: run() forks tasks onto the scheduler and wait() joins them, running queued tasks
+	// while it waits.
+	class TaskGroup
+	{
+	private:
+		TaskScheduler* scheduler;
+		std::atomic<int> pending_tasks;
+
+	public:
+		TaskGroup();
+		~TaskGroup();
+
+		void run(std::function<void()> task);
+		void wait();
+	};
+}
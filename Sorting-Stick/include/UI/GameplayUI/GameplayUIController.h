@@ -3,6 +3,8 @@
 #include "UI/UIElement/TextView.h"
 #include "UI/UIElement/ButtonView.h"
 #include "UI/UIElement/ImageView.h"
+#include "Gameplay/Collection/StickCollectionModel.h"
+#include "Sorting/StabilityCheck.h"
 
 namespace UI
 {
@@ -15,6 +17,7 @@ namespace UI
 
 			const float text_y_position = 36.f;
 			const float text_y_pos2 = 76.f;
+			const float text_y_pos3 = 116.f;
 			const float search_type_text_x_position = 60.f;
 			const float comparisons_text_x_position = 580.f;
 			const float array_access_text_x_position = 1170.f;
@@ -22,6 +25,7 @@ namespace UI
 			const float num_sticks_text_x_position = 60.f;
 			const float delay_text_x_position = 687.f;
 			const float time_complexity_text_x_position = 1250.f;
+			const float stability_text_x_position = 60.f;
 
 			const float menu_button_x_position = 1770.f;
 			const float menu_button_y_position = 33.f;
@@ -32,12 +36,33 @@ namespace UI
 			const float image_width = 50.f;
 			const float image_height = 50.f;
 
+			// Counters that change on every sort operation are re-laid out at most this many times per second.
+			const float counter_refresh_rate = 15.f;
+
+			static const int text_buffer_size = 64;
+			char text_buffer[text_buffer_size];
+
+			// Values currently shown, so a text is only re-laid out when its value changes.
+			bool has_displayed_values;
+			bool displayed_race_mode;
+			Gameplay::Collection::SortType displayed_sort_type;
+			long long displayed_comparisons;
+			long long displayed_array_access;
+			int displayed_num_sticks;
+			int displayed_delay;
+			sf::String displayed_time_complexity;
+			bool displayed_stable_sort;
+			Sorting::StabilityCheck displayed_stability_check;
+
+			sf::Clock counter_refresh_clock;
+
 			UIElement::TextView* search_type_text;
 			UIElement::TextView* comparisons_text;
 			UIElement::TextView* array_access_text;
 			UIElement::TextView* num_sticks_text;
 			UIElement::TextView* delay_text;
 			UIElement::TextView* time_complexity_text;
+			UIElement::TextView* stability_text;
 			UIElement::ButtonView* menu_button;
 
 			void createButton();
@@ -51,6 +76,10 @@ namespace UI
 			void updateNumberOfSticksText();
 			void updateDelayText();
 			void updateTimeComplexityText();
+			void updateStabilityText();
+			void updateRaceTexts();
+			bool shouldRefreshCounters();
+			const char* formatCounterText(const char* label, long long value);
 			void menuButtonCallback();
 			void registerButtonCallback();
 
@@ -3,6 +3,10 @@
 #include "UI/Interface/IUIController.h"
 #include "UI/UIElement/ImageView.h"
 #include "UI/UIElement/ButtonView.h"
+#include "UI/UIElement/TextView.h"
+#include "UI/UIElement/SliderView.h"
+#include "Gameplay/Collection/StickCollectionModel.h"
+#include <vector>
 
 namespace UI
 {
@@ -27,6 +31,25 @@ namespace UI
 			const float quick_sort_button_y_position = 400.f;
 			const float radix_sort_button_y_position = 600.f;
 			const float quit_button_y_position = 830.f;
+			const float race_button_y_position = 830.f;
+			const float race_label_y_offset = -50.f;
+			const int race_label_font_size = 40;
+
+			// Sorts without a dedicated button texture sit in a narrower center column, labelled above.
+			const float center_column_button_x_position = 810.f;
+			const float center_column_button_width = 300.f;
+			const float center_column_button_height = 70.f;
+			static const int center_column_slots = 6;
+			const float center_column_button_y_positions[center_column_slots] = { 830.f, 704.f, 578.f, 452.f, 326.f, 200.f };
+
+			// Stick count slider:
+			const float sticks_label_x_position = 420.f;
+			const float sticks_label_y_position = 70.f;
+			const float sticks_slider_x_position = 960.f;
+			const float sticks_slider_y_position = 100.f;
+			const float sticks_slider_width = 540.f;
+			const float sticks_slider_height = 14.f;
+			const int sticks_label_font_size = 40;
 
 			// References:
 			UIElement::ImageView* background_image;
@@ -37,11 +60,22 @@ namespace UI
 			UIElement::ButtonView* quick_sort_button;
 			UIElement::ButtonView* radix_sort_button;
 			UIElement::ButtonView* quit_button;
+			UIElement::ButtonView* race_button;
+			UIElement::TextView* race_label;
+			std::vector<Gameplay::Collection::SortType> center_column_sort_types;
+			std::vector<UIElement::ButtonView*> center_column_buttons;
+			std::vector<UIElement::TextView*> center_column_labels;
+			UIElement::TextView* sticks_label;
+			UIElement::SliderView* sticks_slider;
+			int displayed_number_of_sticks;
 
 			const float background_alpha = 85.f;
 
 			void createImage();
 			void createButtons();
+			void createText();
+			void initializeText();
+			void initializeSlider();
 			void initializeBackgroundImage();
 			void initializeButtons();
 			void registerButtonCallback();
@@ -52,6 +86,10 @@ namespace UI
 			void mergeSortButtonCallback();
 			void quickSortButtonCallback();
 			void radixSortButtonCallback();
+			void raceButtonCallback();
+			void centerColumnButtonCallback(Gameplay::Collection::SortType sort_type);
+			void sticksSliderCallback(float value);
+			void updateSticksLabel(int number_of_sticks);
 			void quitButtonCallback();
 
 			void destroy();
@@ -0,0 +1,69 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include "UI/Interface/IUIController.h"
+#include "UI/UIElement/TextView.h"
+#include "UI/UIElement/RectangleShapeView.h"
+
+namespace UI
+{
+	namespace PerformanceOverlay
+	{
+		class PerformanceOverlayUIController : public Interface::IUIController
+		{
+		private:
+			static const int histogram_bucket_count = 8;
+
+			const float sample_interval_seconds = 0.25f;
+			const float histogram_bucket_width_ms = 4.f;
+
+			const int font_size = 26;
+			const float panel_x_position = 40.f;
+			const float panel_y_position = 130.f;
+			const float panel_width = 470.f;
+			const float panel_height = 436.f;
+			const float text_x_position = 60.f;
+			const float first_text_y_position = 145.f;
+			const float text_line_spacing = 36.f;
+
+			const float histogram_x_position = 60.f;
+			const float histogram_base_y_position = 546.f;
+			const float histogram_max_bar_height = 130.f;
+			const float histogram_bar_width = 44.f;
+			const float histogram_bar_spacing = 9.f;
+
+			const sf::Color panel_color = sf::Color(0, 0, 0, 170);
+			const sf::Color histogram_bar_color = sf::Color(80, 200, 120);
+
+			bool overlay_visible;
+			sf::Clock sample_clock;
+			long long last_sort_operation_count;
+
+			UIElement::RectangleShapeView* background_panel;
+			UIElement::TextView* frame_time_text;
+			UIElement::TextView* update_render_text;
+			UIElement::TextView* draw_calls_text;
+			UIElement::TextView* sort_throughput_text;
+			UIElement::TextView* memory_text;
+			UIElement::TextView* worker_text;
+			UIElement::TextView* histogram_title_text;
+			UIElement::RectangleShapeView* histogram_bars[histogram_bucket_count];
+
+			void createElements();
+			void initializeElements();
+			void handleToggleInput();
+
+			void sampleStatistics();
+			void updateHistogramBars();
+			void destroy();
+
+		public:
+			PerformanceOverlayUIController();
+			~PerformanceOverlayUIController();
+
+			void initialize() override;
+			void update() override;
+			void render() override;
+			void show() override;
+		};
+	}
+}
@@ -8,7 +8,6 @@ namespace UI
 		class ImageView : public UIView
 		{
 		protected:
-			sf::Texture image_texture;
 			sf::Sprite image_sprite;
 
 		public:
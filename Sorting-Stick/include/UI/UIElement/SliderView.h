@@ -0,0 +1,54 @@
+#pragma once
+#include "UI/UIElement/UIView.h"
+#include <functional>
+
+namespace UI
+{
+	namespace UIElement
+	{
+		// Horizontal slider dragged with the left mouse button. With logarithmic mapping every
+		// decade of the range takes the same track length, so 10 and 10^8 can share one slider.
+		class SliderView : public UIView
+		{
+		private:
+			using CallbackFunction = std::function<void(float)>;
+
+			// Called once with the final value when a drag ends.
+			CallbackFunction callback_function = nullptr;
+
+			const float knob_radius_ratio = 1.1f; // relative to the track height
+			const sf::Color track_color = sf::Color(90, 90, 90);
+			const sf::Color fill_color = sf::Color(0, 180, 255);
+			const sf::Color knob_color = sf::Color::White;
+
+			sf::RectangleShape track_shape;
+			sf::RectangleShape fill_shape;
+			sf::CircleShape knob_shape;
+
+			float min_value;
+			float max_value;
+			float value;
+			bool logarithmic;
+			bool dragging;
+
+			float valueToRatio(float slider_value) const;
+			float ratioToValue(float ratio) const;
+			void updateShapes();
+			void handleSliderInteraction();
+
+		public:
+			SliderView();
+			virtual ~SliderView();
+
+			virtual void initialize(sf::Vector2f position, float slider_width, float slider_height, float min_value, float max_value, float initial_value, bool logarithmic = false);
+			virtual void update() override;
+			virtual void render() override;
+
+			void setValue(float slider_value);
+			float getValue() const;
+			bool isDragging() const;
+
+			void registerCallbackFuntion(CallbackFunction slider_callback);
+		};
+	}
+}
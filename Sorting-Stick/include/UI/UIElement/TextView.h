@@ -16,9 +16,6 @@ namespace UI
 		private:
 			static const int default_font_size = 55;
 
-			static sf::Font font_bubble_bobble;
-			static sf::Font font_DS_DIGIB;
-
 			sf::Text text;
 
 			static void loadFont();
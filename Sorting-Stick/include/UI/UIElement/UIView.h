@@ -19,6 +19,7 @@ namespace UI
 
 			sf::Vector2f getPositionForCurrentResolution(sf::Vector2f position);
 			sf::Vector2f getScaleForCurrentResolution(float width, float height);
+			void draw(const sf::Drawable& drawable);
 
 		public:
 			UIView();
@@ -2,6 +2,7 @@
 #include "UI/MainMenu/MainMenuUIController.h"
 #include "UI/SplashScreen/SplashScreenUIController.h"
 #include "UI/GameplayUI/GameplayUIController.h"
+#include "UI/PerformanceOverlay/PerformanceOverlayUIController.h"
 #include "UI/Interface/IUIController.h"
 
 namespace UI
@@ -12,9 +13,11 @@ namespace UI
 		SplashScreen::SplashScreenUIController* splash_screen_controller;
 		MainMenu::MainMenuUIController* main_menu_controller;
 		GameplayUI::GameplayUIController* gameplay_controller;
+		PerformanceOverlay::PerformanceOverlayUIController* performance_overlay_controller;
+
+		bool asset_dependent_controllers_initialized;
 
 		void createControllers();
-		void initializeControllers();
 		Interface::IUIController* getCurrentUIController();
 		void destroy();
 
@@ -23,6 +26,7 @@ namespace UI
 		~UIService();
 
 		void initialize();
+		void initializeAssetDependentControllers();
 		void update();
 		void render();
 		void showScreen();
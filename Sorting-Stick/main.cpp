@@ -1,9 +1,17 @@
 #include "Main/GameService.h"
+#include "Global/CommandLineOptions.h"
+#include "Gameplay/Collection/ExternalMergeSorter.h"
+#include "Benchmark/BenchmarkRunner.h"
 
-int main()
+int main(int argc, char* argv[])
 {
     using namespace Main;
 
+    Global::CommandLineOptions::parse(argc, argv);
+
+    if (Global::CommandLineOptions::getExternalSortInput()) return Gameplay::Collection::ExternalMergeSorter::sortFromCommandLine();
+    if (Global::CommandLineOptions::getBenchmark()) return Benchmark::BenchmarkRunner::runFromCommandLine();
+
     GameService* game_service = new GameService();
     game_service->ignite();
 
@@ -0,0 +1,541 @@
+#include "Benchmark/BenchmarkRunner.h"
+#include "Global/CommandLineOptions.h"
+#include "Global/HugePageArena.h"
+#include "Gameplay/Collection/InputGenerator.h"
+#include "Profiling/TlbMissCounter.h"
+#include "Sorting/AmericanFlagSort.h"
+#include "Sorting/ArgSort.h"
+#include "Sorting/MultiwayMergeSort.h"
+#include "Sorting/ParallelSort.h"
+#include "Sorting/RadixSort.h"
+#include "Sorting/Selection.h"
+#include "Sorting/StabilityCheck.h"
+#include "Threading/NumaMemory.h"
+#include "Threading/TaskScheduler.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <random>
+
+namespace Benchmark
+{
+	using namespace Global;
+	using namespace Gameplay::Collection;
+
+	int BenchmarkRunner::runFromCommandLine()
+	{
+		const char* benchmark_name = CommandLineOptions::getBenchmark();
+		Threading::NumaMemory::initializeFromCommandLine();
+		Threading::TaskScheduler::getInstance()->initialize(CommandLineOptions::getNumberOfThreads());
+
+		if (std::strcmp(benchmark_name, "merge") == 0) runMergeBenchmark();
+		else if (std::strcmp(benchmark_name, "keys") == 0) runKeyTypesBenchmark();
+		else if (std::strcmp(benchmark_name, "records") == 0) runRecordsBenchmark();
+		else if (std::strcmp(benchmark_name, "stability") == 0) runStabilityBenchmark();
+		else if (std::strcmp(benchmark_name, "select") == 0) runSelectionBenchmark();
+		else if (std::strcmp(benchmark_name, "radix") == 0) runRadixBenchmark();
+		else if (std::strcmp(benchmark_name, "parallel") == 0) runParallelBenchmark();
+		else if (std::strcmp(benchmark_name, "numa") == 0) runNumaBenchmark();
+		else if (std::strcmp(benchmark_name, "hugepages") == 0) runHugePagesBenchmark();
+		else
+		{
+			printf("Unknown benchmark %s, available: merge, keys, records, stability, select, radix, parallel, numa, hugepages\n", benchmark_name);
+			return 1;
+		}
+		return 0;
+	}
+
+	int BenchmarkRunner::getNumberOfValues()
+	{
+		return CommandLineOptions::getNumberOfSticks() > 0 ? CommandLineOptions::getNumberOfSticks() : default_number_of_values;
+	}
+
+	std::uint64_t BenchmarkRunner::getSeed()
+	{
+		return CommandLineOptions::hasInputSeed() ? CommandLineOptions::getInputSeed() : 1;
+	}
+
+	std::vector<int> BenchmarkRunner::generateRandomValues(int number_of_values)
+	{
+		std::vector<int> values(number_of_values);
+		InputGenerator generator(InputDistribution::RANDOM, getSeed(), number_of_values);
+		generator.fill([&values, &generator](int first_index, int last_index)
+			{
+				for (int i = first_index; i < last_index; i++) values[i] = generator.valueAt(i);
+			});
+		return values;
+	}
+
+	// Each merge pass reads and writes every element once, so memory traffic falls with the number of
+	// passes, ceil(log_k(n / base run)), while each output costs log2(k) comparisons in the loser tree.
+	void BenchmarkRunner::runMergeBenchmark()
+	{
+		int number_of_values = getNumberOfValues();
+		std::vector<int> input = generateRandomValues(number_of_values);
+		std::vector<int> values(number_of_values);
+
+		printf("Multiway merge sort of %d random 32 bit keys\n", number_of_values);
+		printf("%10s %8s %14s %10s %12s\n", "ways", "passes", "traffic MiB", "time ms", "ns/element");
+
+		std::copy(input.begin(), input.end(), values.begin());
+		std::chrono::steady_clock::time_point start_time = std::chrono::steady_clock::now();
+		std::stable_sort(values.begin(), values.end());
+		double baseline_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start_time).count();
+		printf("%10s %8s %14s %10.1f %12.2f\n", "stable", "-", "-", baseline_ms, baseline_ms * 1e6 / number_of_values);
+
+		for (std::size_t ways = 2; ways <= 256; ways *= 2)
+		{
+			std::copy(input.begin(), input.end(), values.begin());
+
+			start_time = std::chrono::steady_clock::now();
+			int passes = Sorting::multiwayMergeSort(values.data(), values.size(), ways);
+			double elapsed_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start_time).count();
+
+			double traffic_mib = 2.0 * passes * number_of_values * sizeof(int) / (1 << 20);
+			printf("%10zu %8d %14.0f %10.1f %12.2f%s\n", ways, passes, traffic_mib, elapsed_ms, elapsed_ms * 1e6 / number_of_values,
+				std::is_sorted(values.begin(), values.end()) ? "" : "  NOT SORTED");
+		}
+	}
+
+	// Scatters copies of -NaN, +NaN, -inf, +inf, -0 and +0 over the keys, so the float sorts have to
+	// place them by their total order.
+	template<typename Float>
+	void BenchmarkRunner::addSpecialFloats(std::vector<Float>& keys, std::uint64_t seed)
+	{
+		const Float special_values[] = {
+			-std::numeric_limits<Float>::quiet_NaN(), std::numeric_limits<Float>::quiet_NaN(),
+			-std::numeric_limits<Float>::infinity(), std::numeric_limits<Float>::infinity(), Float(-0.0), Float(0.0) };
+
+		std::mt19937_64 random_engine(seed);
+		std::size_t copies = std::max<std::size_t>(1, keys.size() / 1024);
+		for (std::size_t i = 0; i < copies && !keys.empty(); i++)
+			for (Float special_value : special_values) keys[random_engine() % keys.size()] = special_value;
+	}
+
+	template<typename Key>
+	void BenchmarkRunner::runKeyTypeBenchmark(const char* key_name, const std::vector<Key>& input)
+	{
+		Sorting::KeyLess<Key> less;
+		std::vector<Key> reference(input);
+		std::vector<Key> values(input);
+
+		std::chrono::steady_clock::time_point start_time = std::chrono::steady_clock::now();
+		std::stable_sort(reference.begin(), reference.end(), less);
+		double stable_sort_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start_time).count();
+
+		start_time = std::chrono::steady_clock::now();
+		int radix_passes = Sorting::radixSort(values.data(), values.size());
+		double radix_sort_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start_time).count();
+		bool radix_sorted = std::memcmp(values.data(), reference.data(), values.size() * sizeof(Key)) == 0;
+
+		std::copy(input.begin(), input.end(), values.begin());
+		start_time = std::chrono::steady_clock::now();
+		Sorting::multiwayMergeSort(values.data(), values.size(), 16);
+		double merge_sort_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start_time).count();
+		bool merge_sorted = std::memcmp(values.data(), reference.data(), values.size() * sizeof(Key)) == 0;
+
+		printf("%-18s %6zu %14.1f %10.1f %8d %14.1f%s\n", key_name, sizeof(Key), stable_sort_ms, radix_sort_ms, radix_passes, merge_sort_ms,
+			radix_sorted && merge_sorted ? "" : "  NOT SORTED");
+	}
+
+	// The stable sorts must agree byte for byte, which checks float total order (signed zeros and
+	// NaNs included) and that key-value records keep their input order among equal keys.
+	void BenchmarkRunner::runKeyTypesBenchmark()
+	{
+		int number_of_values = getNumberOfValues();
+		std::mt19937_64 random_engine(getSeed());
+
+		printf("Sorting %d random keys of each type\n", number_of_values);
+		printf("%-18s %6s %14s %10s %8s %14s\n", "key", "bytes", "stable_sort ms", "radix ms", "passes", "16-way ms");
+
+		std::vector<std::int32_t> int32_keys(number_of_values);
+		for (std::int32_t& key : int32_keys) key = static_cast<std::int32_t>(random_engine());
+		runKeyTypeBenchmark("int32", int32_keys);
+
+		std::vector<std::int64_t> int64_keys(number_of_values);
+		for (std::int64_t& key : int64_keys) key = static_cast<std::int64_t>(random_engine());
+		runKeyTypeBenchmark("int64", int64_keys);
+
+		std::normal_distribution<float> float_distribution(0.0f, 1000.0f);
+		std::vector<float> float_keys(number_of_values);
+		for (float& key : float_keys) key = float_distribution(random_engine);
+		addSpecialFloats(float_keys, random_engine());
+		runKeyTypeBenchmark("float", float_keys);
+
+		std::normal_distribution<double> double_distribution(0.0, 1000.0);
+		std::vector<double> double_keys(number_of_values);
+		for (double& key : double_keys) key = double_distribution(random_engine);
+		addSpecialFloats(double_keys, random_engine());
+		runKeyTypeBenchmark("double", double_keys);
+
+		std::vector<Sorting::FixedString<16>> string_keys(number_of_values);
+		for (Sorting::FixedString<16>& key : string_keys)
+			for (unsigned char& character : key.bytes) character = static_cast<unsigned char>('a' + random_engine() % 26);
+		runKeyTypeBenchmark("string16", string_keys);
+
+		std::vector<Sorting::KeyValue<std::int32_t, std::int32_t>> record_keys(number_of_values);
+		for (int i = 0; i < number_of_values; i++) record_keys[i] = { static_cast<std::int32_t>(random_engine() % 1024), i };
+		runKeyTypeBenchmark("int32 + payload", record_keys);
+	}
+
+	// Records with a 60 byte payload, sorted by a 32 bit key with few distinct values so stability
+	// matters. Sorting the records directly moves every payload on every pass; sorting packed
+	// key+index words and gathering once moves each payload a single time.
+	void BenchmarkRunner::runRecordsBenchmark()
+	{
+		struct Payload { std::int32_t words[15]; };
+		using Record = Sorting::KeyValue<std::int32_t, Payload>;
+
+		int number_of_values = getNumberOfValues();
+		std::mt19937_64 random_engine(getSeed());
+
+		std::vector<Record> input(number_of_values);
+		for (int i = 0; i < number_of_values; i++)
+		{
+			input[i].key = static_cast<std::int32_t>(random_engine() % 65536) - 32768;
+			for (std::int32_t& word : input[i].payload.words) word = i;
+		}
+
+		printf("Sorting %d records of %zu bytes by a 32 bit key\n", number_of_values, sizeof(Record));
+		printf("%-28s %10s %12s\n", "method", "time ms", "ns/element");
+
+		std::vector<Record> reference(input);
+		std::chrono::steady_clock::time_point start_time = std::chrono::steady_clock::now();
+		std::stable_sort(reference.begin(), reference.end(), Sorting::KeyLess<Record>());
+		double elapsed_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start_time).count();
+		printf("%-28s %10.1f %12.2f\n", "stable_sort records", elapsed_ms, elapsed_ms * 1e6 / number_of_values);
+
+		std::vector<Record> records(input);
+		start_time = std::chrono::steady_clock::now();
+		Sorting::radixSort(records.data(), records.size());
+		elapsed_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start_time).count();
+		bool sorted = std::memcmp(records.data(), reference.data(), records.size() * sizeof(Record)) == 0;
+		printf("%-28s %10.1f %12.2f%s\n", "radix sort records", elapsed_ms, elapsed_ms * 1e6 / number_of_values, sorted ? "" : "  NOT SORTED");
+
+		std::vector<std::int32_t> keys(number_of_values);
+		std::vector<Payload> payloads(number_of_values);
+		for (int i = 0; i < number_of_values; i++)
+		{
+			keys[i] = input[i].key;
+			payloads[i] = input[i].payload;
+		}
+
+		start_time = std::chrono::steady_clock::now();
+		std::vector<std::uint32_t> indices = Sorting::argSort(keys.data(), keys.size());
+		elapsed_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start_time).count();
+		printf("%-28s %10.1f %12.2f\n", "argsort (packed key+index)", elapsed_ms, elapsed_ms * 1e6 / number_of_values);
+
+		start_time = std::chrono::steady_clock::now();
+		Sorting::sortByKey(keys.data(), payloads.data(), keys.size());
+		elapsed_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start_time).count();
+
+		sorted = true;
+		for (int i = 0; i < number_of_values && sorted; i++)
+			sorted = keys[i] == reference[i].key && std::memcmp(&payloads[i], &reference[i].payload, sizeof(Payload)) == 0;
+		printf("%-28s %10.1f %12.2f%s\n", "sort by key + one gather", elapsed_ms, elapsed_ms * 1e6 / number_of_values, sorted ? "" : "  NOT SORTED");
+	}
+
+	// Keys with only 256 distinct values, each tagged with its input position. After every sort one
+	// pass over the (key, index) pairs reports whether equal keys kept their input order.
+	void BenchmarkRunner::runStabilityBenchmark()
+	{
+		using Record = Sorting::KeyValue<std::int32_t, std::uint32_t>;
+
+		int number_of_values = getNumberOfValues();
+		std::mt19937_64 random_engine(getSeed());
+
+		std::vector<Record> input(number_of_values);
+		for (int i = 0; i < number_of_values; i++) input[i] = { static_cast<std::int32_t>(random_engine() % 256), static_cast<std::uint32_t>(i) };
+
+		std::vector<Record> records(number_of_values);
+		Sorting::KeyLess<Record> less;
+		auto index_of = [](const Record& record) { return record.payload; };
+
+		printf("Stability of %d keys with 256 distinct values\n", number_of_values);
+		printf("%-22s %10s %12s %12s\n", "method", "time ms", "check ms", "result");
+
+		auto run = [&](const char* method_name, auto sort_function)
+			{
+				std::copy(input.begin(), input.end(), records.begin());
+
+				std::chrono::steady_clock::time_point start_time = std::chrono::steady_clock::now();
+				sort_function();
+				double sort_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start_time).count();
+
+				start_time = std::chrono::steady_clock::now();
+				Sorting::StabilityCheck check = Sorting::checkStableOrder(records.data(), records.size(), less, index_of);
+				double check_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start_time).count();
+
+				printf("%-22s %10.1f %12.2f %12s\n", method_name, sort_ms, check_ms, Sorting::getStabilityCheckName(check));
+			};
+
+		run("std::sort", [&]() { std::sort(records.begin(), records.end(), less); });
+		run("std::stable_sort", [&]() { std::stable_sort(records.begin(), records.end(), less); });
+		run("radix sort", [&]() { Sorting::radixSort(records.data(), records.size()); });
+		run("16-way merge sort", [&]() { Sorting::multiwayMergeSort(records.data(), records.size(), 16); });
+		run("argsort + gather", [&]()
+			{
+				std::vector<std::int32_t> keys(number_of_values);
+				for (int i = 0; i < number_of_values; i++) keys[i] = records[i].key;
+				std::vector<std::uint32_t> indices = Sorting::argSort(keys.data(), keys.size());
+				for (int i = 0; i < number_of_values; i++) records[i] = input[indices[i]];
+			});
+	}
+
+	// Partial sort, nth element and top k against a full sort of the same keys, with k = n / 100 and
+	// nth the median. Each result is checked against the fully sorted reference.
+	void BenchmarkRunner::runSelectionBenchmark()
+	{
+		int number_of_values = getNumberOfValues();
+		std::size_t k = std::max(1, number_of_values / 100);
+		std::size_t nth = number_of_values / 2;
+
+		std::vector<int> input = generateRandomValues(number_of_values);
+		std::vector<int> values(input);
+		std::vector<int> top(k);
+
+		printf("Selection from %d random 32 bit keys, k = %zu\n", number_of_values, k);
+		printf("%-28s %10s %10s\n", "method", "time ms", "speedup");
+
+		std::chrono::steady_clock::time_point start_time = std::chrono::steady_clock::now();
+		std::sort(values.begin(), values.end());
+		double full_sort_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start_time).count();
+		printf("%-28s %10.1f %10s\n", "std::sort (full)", full_sort_ms, "1.0x");
+
+		const std::vector<int> sorted(values);
+		auto run = [&](const char* method_name, auto select_function, auto is_correct)
+			{
+				std::copy(input.begin(), input.end(), values.begin());
+
+				start_time = std::chrono::steady_clock::now();
+				select_function();
+				double elapsed_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start_time).count();
+
+				printf("%-28s %10.1f %9.1fx%s\n", method_name, elapsed_ms, full_sort_ms / elapsed_ms, is_correct() ? "" : "  WRONG");
+			};
+
+		auto smallest_k_sorted = [&]() { return std::equal(values.begin(), values.begin() + k, sorted.begin()); };
+		auto median_placed = [&]() { return values[nth] == sorted[nth]; };
+		auto largest_k_found = [&]() { return std::equal(top.begin(), top.end(), sorted.rbegin()); };
+
+		run("std::partial_sort", [&]() { std::partial_sort(values.begin(), values.begin() + k, values.end()); }, smallest_k_sorted);
+		run("partial sort (Floyd-Rivest)", [&]() { Sorting::partialSort(values.data(), values.size(), k); }, smallest_k_sorted);
+		run("std::nth_element", [&]() { std::nth_element(values.begin(), values.begin() + nth, values.end()); }, median_placed);
+		run("nth element (Floyd-Rivest)", [&]() { Sorting::nthElement(values.data(), values.size(), nth); }, median_placed);
+		run("top k (parallel heaps)", [&]() { Sorting::topK(values.data(), values.size(), k, top.data()); }, largest_k_found);
+	}
+
+	template<typename Key>
+	void BenchmarkRunner::runRadixKeyTypeBenchmark(const char* key_name, const std::vector<Key>& input)
+	{
+		Sorting::KeyLess<Key> less;
+		std::vector<Key> reference(input);
+		std::vector<Key> values(input);
+
+		std::chrono::steady_clock::time_point start_time = std::chrono::steady_clock::now();
+		std::sort(reference.begin(), reference.end(), less);
+		double std_sort_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start_time).count();
+
+		start_time = std::chrono::steady_clock::now();
+		Sorting::radixSort(values.data(), values.size());
+		double lsd_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start_time).count();
+		bool lsd_sorted = std::memcmp(values.data(), reference.data(), values.size() * sizeof(Key)) == 0;
+
+		std::copy(input.begin(), input.end(), values.begin());
+		start_time = std::chrono::steady_clock::now();
+		Sorting::americanFlagSort(values.data(), values.size());
+		double american_flag_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start_time).count();
+		bool american_flag_sorted = std::is_sorted(values.begin(), values.end(), less);
+
+		double buffer_mib = static_cast<double>(input.size() * sizeof(Key)) / (1 << 20);
+		printf("%-12s %12.1f %10.1f %12.1f %18.1f%s\n", key_name, std_sort_ms, lsd_ms, buffer_mib, american_flag_ms,
+			lsd_sorted && american_flag_sorted ? "" : "  NOT SORTED");
+	}
+
+	// The LSD radix sort scatters into a buffer as large as the input; the American flag sort permutes
+	// in place and only keeps 256 entry bucket tables on the stack.
+	void BenchmarkRunner::runRadixBenchmark()
+	{
+		int number_of_values = getNumberOfValues();
+		std::mt19937_64 random_engine(getSeed());
+
+		printf("Radix sorting %d random keys\n", number_of_values);
+		printf("%-12s %12s %10s %12s %18s\n", "key", "std::sort ms", "LSD ms", "buffer MiB", "American flag ms");
+
+		std::vector<std::int32_t> int32_keys(number_of_values);
+		for (std::int32_t& key : int32_keys) key = static_cast<std::int32_t>(random_engine());
+		runRadixKeyTypeBenchmark("int32", int32_keys);
+
+		for (std::int32_t& key : int32_keys) key = static_cast<std::int32_t>(random_engine() % 1000);
+		runRadixKeyTypeBenchmark("int32 <1000", int32_keys);
+
+		std::vector<std::int64_t> int64_keys(number_of_values);
+		for (std::int64_t& key : int64_keys) key = static_cast<std::int64_t>(random_engine());
+		runRadixKeyTypeBenchmark("int64", int64_keys);
+
+		std::normal_distribution<double> double_distribution(0.0, 1000.0);
+		std::vector<double> double_keys(number_of_values);
+		for (double& key : double_keys) key = double_distribution(random_engine);
+		runRadixKeyTypeBenchmark("double", double_keys);
+	}
+
+	// Scaling of the fork/join merge sort with the worker count; --threads sets the pool size. The
+	// pool statistics show how evenly the tasks were spread and how many had to be stolen.
+	void BenchmarkRunner::runParallelBenchmark()
+	{
+		int number_of_values = getNumberOfValues();
+		std::vector<int> input = generateRandomValues(number_of_values);
+		std::vector<int> values(number_of_values);
+		std::vector<int> expected(input);
+		std::sort(expected.begin(), expected.end());
+
+		Threading::TaskScheduler* task_scheduler = Threading::TaskScheduler::getInstance();
+		printf("Sorting %d random 32 bit keys on %d worker threads\n", number_of_values, task_scheduler->getThreadCount());
+		printf("%-22s %10s %12s %9s %10s %8s %6s\n", "sort", "time ms", "ns/element", "speedup", "tasks", "stolen", "busy");
+
+		double baseline_ms = 0.0;
+		auto run = [&](const char* sort_name, auto sort_values)
+			{
+				std::copy(input.begin(), input.end(), values.begin());
+				Threading::TaskSchedulerStats start_stats = task_scheduler->getStats();
+
+				std::chrono::steady_clock::time_point start_time = std::chrono::steady_clock::now();
+				sort_values();
+				double elapsed_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start_time).count();
+
+				Threading::TaskSchedulerStats stats = task_scheduler->getStats();
+				if (baseline_ms == 0.0) baseline_ms = elapsed_ms;
+
+				printf("%-22s %10.1f %12.2f %8.2fx %10llu %8llu %5.0f%%%s\n", sort_name, elapsed_ms, elapsed_ms * 1e6 / number_of_values, baseline_ms / elapsed_ms,
+					static_cast<unsigned long long>(stats.tasks_executed - start_stats.tasks_executed), static_cast<unsigned long long>(stats.tasks_stolen - start_stats.tasks_stolen),
+					stats.utilization * 100.f, values == expected ? "" : "  WRONG");
+			};
+
+		run("std::stable_sort", [&]() { std::stable_sort(values.begin(), values.end()); });
+		run("parallel merge sort", [&]() { Sorting::parallelMergeSort(values.data(), values.size()); });
+	}
+
+	// Where the pages of a parallel sort's input and scratch buffer end up. With "off" the main thread
+	// zeroes every page first, so on a multi-socket machine they all sit on its node and the workers of
+	// the other sockets read across the interconnect; with first touch the generating and sorting tasks
+	// place the pages they work on. The sum is a pure bandwidth pass over the sorted input.
+	void BenchmarkRunner::runNumaBenchmark()
+	{
+		using namespace Threading;
+
+		int number_of_values = getNumberOfValues();
+		InputGenerator generator(InputDistribution::RANDOM, getSeed(), number_of_values);
+		TaskScheduler* task_scheduler = TaskScheduler::getInstance();
+		NumaPolicy configured_policy = NumaMemory::getPolicy();
+
+		printf("Sorting %d random 32 bit keys on %d workers, %d NUMA node(s), libnuma %s, threads %s\n", number_of_values, task_scheduler->getThreadCount(), NumaMemory::getNodeCount(),
+			NumaMemory::isNumaLibraryAvailable() ? "loaded" : "not available", NumaMemory::isThreadPinningEnabled() ? "pinned" : "not pinned (--pin-threads=1)");
+		printf("%-12s %10s %10s %10s   %s\n", "policy", "fill ms", "sort ms", "sum ms", "input pages per node");
+
+		const NumaPolicy policies[] = { NumaPolicy::OFF, NumaPolicy::FIRST_TOUCH, NumaPolicy::INTERLEAVE };
+		for (NumaPolicy policy : policies)
+		{
+			if (policy == NumaPolicy::INTERLEAVE && !NumaMemory::isNumaLibraryAvailable())
+			{
+				printf("%-12s needs libnuma\n", NumaMemory::getPolicyName(policy));
+				continue;
+			}
+			// Every pass starts from fresh pages so none inherit the previous pass's placement.
+			HugePageArena::getInstance()->trim();
+			NumaMemory::setPolicy(policy);
+
+			std::chrono::steady_clock::time_point start_time = std::chrono::steady_clock::now();
+			NumaBuffer<int> values(number_of_values);
+			generator.fill([&values, &generator](int first_index, int last_index)
+				{
+					for (int i = first_index; i < last_index; i++) values[i] = generator.valueAt(i);
+				});
+			double fill_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start_time).count();
+
+			start_time = std::chrono::steady_clock::now();
+			Sorting::parallelMergeSort(values.data(), values.size());
+			double sort_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start_time).count();
+
+			std::atomic<long long> sum(0);
+			start_time = std::chrono::steady_clock::now();
+			task_scheduler->parallelFor(0, values.size(), 1 << 16, [&values, &sum](std::size_t first_index, std::size_t last_index)
+				{
+					long long chunk_sum = 0;
+					for (std::size_t i = first_index; i < last_index; i++) chunk_sum += values[i];
+					sum += chunk_sum;
+				});
+			double sum_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start_time).count();
+
+			char placement[128] = "unknown";
+			std::vector<std::size_t> pages_per_node;
+			if (NumaMemory::countPagesPerNode(values.data(), values.size() * sizeof(int), pages_per_node))
+			{
+				int length = 0;
+				for (std::size_t node = 0; node < pages_per_node.size() && length < static_cast<int>(sizeof(placement)); node++)
+					length += std::snprintf(placement + length, sizeof(placement) - length, node == 0 ? "%zu" : " / %zu", pages_per_node[node]);
+			}
+
+			printf("%-12s %10.1f %10.1f %10.1f   %s%s\n", NumaMemory::getPolicyName(policy), fill_ms, sort_ms, sum_ms, placement,
+				std::is_sorted(values.data(), values.data() + values.size()) ? "" : "  WRONG");
+		}
+
+		NumaMemory::setPolicy(configured_policy);
+	}
+
+	// LSD radix sort of keys held in arena buffers, with and without huge pages. The first run of each
+	// setting maps fresh blocks, so its fill pays the page faults; the later runs reuse the blocks.
+	// The sort runs on the calling thread, which is the one the TLB counter watches.
+	void BenchmarkRunner::runHugePagesBenchmark()
+	{
+		using namespace Threading;
+		const int runs_per_setting = 3;
+
+		int number_of_values = getNumberOfValues();
+		InputGenerator generator(InputDistribution::RANDOM, getSeed(), number_of_values);
+		HugePageArena* arena = HugePageArena::getInstance();
+		bool configured_huge_pages = arena->areHugePagesEnabled();
+		Profiling::TlbMissCounter tlb_miss_counter;
+
+		printf("Radix sorting %d random 32 bit keys, dTLB misses %s\n", number_of_values, tlb_miss_counter.isAvailable() ? "counted with perf events" : "not measurable here");
+		printf("%-24s %8s %10s %10s %14s %10s\n", "pages", "run", "fill ms", "sort ms", "dTLB misses", "per key");
+
+		const bool huge_page_settings[] = { false, true };
+		for (bool huge_pages : huge_page_settings)
+		{
+			arena->setHugePagesEnabled(huge_pages);
+
+			for (int run = 0; run < runs_per_setting; run++)
+			{
+				std::chrono::steady_clock::time_point start_time = std::chrono::steady_clock::now();
+				NumaBuffer<int> values(number_of_values);
+				generator.fill([&values, &generator](int first_index, int last_index)
+					{
+						for (int i = first_index; i < last_index; i++) values[i] = generator.valueAt(i);
+					});
+				double fill_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start_time).count();
+
+				start_time = std::chrono::steady_clock::now();
+				tlb_miss_counter.start();
+				Sorting::radixSort(values.data(), values.size());
+				long long tlb_misses = tlb_miss_counter.stop();
+				double sort_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start_time).count();
+
+				char misses[32] = "-";
+				char misses_per_key[32] = "-";
+				if (tlb_misses >= 0)
+				{
+					std::snprintf(misses, sizeof(misses), "%lld", tlb_misses);
+					std::snprintf(misses_per_key, sizeof(misses_per_key), "%.3f", static_cast<double>(tlb_misses) / number_of_values);
+				}
+
+				printf("%-24s %8s %10.1f %10.1f %14s %10s%s\n", HugePageArena::getPageBackingName(arena->getPageBacking(values.data())), run == 0 ? "fresh" : "reused",
+					fill_ms, sort_ms, misses, misses_per_key, std::is_sorted(values.data(), values.data() + values.size()) ? "" : "  WRONG");
+			}
+		}
+
+		arena->setHugePagesEnabled(configured_huge_pages);
+	}
+}
@@ -1,6 +1,7 @@
 #include "Event/EventService.h"
 #include "Global/ServiceLocator.h"
 #include "Graphics/GraphicService.h"
+#include "Profiling/TraceRecorder.h"
 #include <iostream>
 
 namespace Event
@@ -8,7 +9,24 @@ namespace Event
     using namespace Global;
     using namespace Graphics;
 
-    EventService::EventService() { game_window = nullptr; }
+    EventService::EventService()
+    {
+        game_window = nullptr;
+        left_mouse_button_state = ButtonState::RELEASED;
+        right_mouse_button_state = ButtonState::RELEASED;
+        space_key_state = ButtonState::RELEASED;
+        left_arrow_key_state = ButtonState::RELEASED;
+        right_arrow_key_state = ButtonState::RELEASED;
+        up_arrow_key_state = ButtonState::RELEASED;
+        down_arrow_key_state = ButtonState::RELEASED;
+        f3_key_state = ButtonState::RELEASED;
+        f4_key_state = ButtonState::RELEASED;
+        f5_key_state = ButtonState::RELEASED;
+        f6_key_state = ButtonState::RELEASED;
+        f7_key_state = ButtonState::RELEASED;
+        f8_key_state = ButtonState::RELEASED;
+        f9_key_state = ButtonState::RELEASED;
+    }
 
     EventService::~EventService() = default;
 
@@ -21,10 +39,24 @@ namespace Event
     {
         updateMouseButtonsState(left_mouse_button_state, sf::Mouse::Left);
         updateMouseButtonsState(right_mouse_button_state, sf::Mouse::Right);
+        updateKeyboardButtonsState(space_key_state, sf::Keyboard::Space);
+        updateKeyboardButtonsState(left_arrow_key_state, sf::Keyboard::Left);
+        updateKeyboardButtonsState(right_arrow_key_state, sf::Keyboard::Right);
+        updateKeyboardButtonsState(up_arrow_key_state, sf::Keyboard::Up);
+        updateKeyboardButtonsState(down_arrow_key_state, sf::Keyboard::Down);
+        updateKeyboardButtonsState(f3_key_state, sf::Keyboard::F3);
+        updateKeyboardButtonsState(f4_key_state, sf::Keyboard::F4);
+        updateKeyboardButtonsState(f5_key_state, sf::Keyboard::F5);
+        updateKeyboardButtonsState(f6_key_state, sf::Keyboard::F6);
+        updateKeyboardButtonsState(f7_key_state, sf::Keyboard::F7);
+        updateKeyboardButtonsState(f8_key_state, sf::Keyboard::F8);
+        updateKeyboardButtonsState(f9_key_state, sf::Keyboard::F9);
     }
 
     void EventService::processEvents()
     {
+        TRACE_SCOPE("EventService::processEvents");
+
         if (isGameWindowOpen())
         {
             // Iterate over all events in the queue.
@@ -56,6 +88,26 @@ namespace Event
         }
     }
 
+    void EventService::updateKeyboardButtonsState(ButtonState& current_button_state, sf::Keyboard::Key keyboard_button)
+    {
+        if (sf::Keyboard::isKeyPressed(keyboard_button))
+        {
+            switch (current_button_state)
+            {
+            case ButtonState::RELEASED:
+                current_button_state = ButtonState::PRESSED;
+                break;
+            case ButtonState::PRESSED:
+                current_button_state = ButtonState::HELD;
+                break;
+            }
+        }
+        else
+        {
+            current_button_state = ButtonState::RELEASED;
+        }
+    }
+
     bool EventService::isGameWindowOpen() { return game_window != nullptr; }
 
     bool EventService::gameWindowWasClosed() { return game_event.type == sf::Event::Closed; }
@@ -66,13 +118,29 @@ namespace Event
 
     bool EventService::pressedEscapeKey() { return game_event.key.code == sf::Keyboard::Escape; }
 
-    bool EventService::pressedLeftArrowKey() { return (isKeyboardEvent() && game_event.key.code == sf::Keyboard::Left); }
+    bool EventService::pressedSpaceKey() { return space_key_state == ButtonState::PRESSED; }
+
+    bool EventService::pressedLeftArrowKey() { return left_arrow_key_state == ButtonState::PRESSED; }
+
+    bool EventService::pressedRightArrowKey() { return right_arrow_key_state == ButtonState::PRESSED; }
+
+    bool EventService::pressedUpArrowKey() { return up_arrow_key_state == ButtonState::PRESSED; }
+
+    bool EventService::pressedDownArrowKey() { return down_arrow_key_state == ButtonState::PRESSED; }
+
+    bool EventService::pressedF3Key() { return f3_key_state == ButtonState::PRESSED; }
+
+    bool EventService::pressedF4Key() { return f4_key_state == ButtonState::PRESSED; }
+
+    bool EventService::pressedF5Key() { return f5_key_state == ButtonState::PRESSED; }
+
+    bool EventService::pressedF6Key() { return f6_key_state == ButtonState::PRESSED; }
 
-    bool EventService::pressedRightArrowKey() { return  (isKeyboardEvent() && game_event.key.code == sf::Keyboard::Right); }
+    bool EventService::pressedF7Key() { return f7_key_state == ButtonState::PRESSED; }
 
-    bool EventService::pressedUpArrowKey() { return  (isKeyboardEvent() && game_event.key.code == sf::Keyboard::Up); }
+    bool EventService::pressedF8Key() { return f8_key_state == ButtonState::PRESSED; }
 
-    bool EventService::pressedDownArrowKey() { return  (isKeyboardEvent() && game_event.key.code == sf::Keyboard::Down); }
+    bool EventService::pressedF9Key() { return f9_key_state == ButtonState::PRESSED; }
 
     bool EventService::pressedLeftMouseButton() { return left_mouse_button_state == ButtonState::PRESSED; }
 
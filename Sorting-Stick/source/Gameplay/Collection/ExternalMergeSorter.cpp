@@ -0,0 +1,201 @@
+#include "Gameplay/Collection/ExternalMergeSorter.h"
+#include "Gameplay/Collection/ExternalRunFile.h"
+#include "Global/MemoryMappedFile.h"
+#include "Global/CommandLineOptions.h"
+#include "Global/HugePageArena.h"
+#include "Sorting/LoserTree.h"
+#include "Sorting/ParallelSort.h"
+#include "Threading/NumaMemory.h"
+#include "Threading/TaskScheduler.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <future>
+
+namespace Gameplay
+{
+	namespace Collection
+	{
+		using namespace Global;
+
+		ExternalMergeSorter::ExternalMergeSorter(std::size_t memory_budget, const std::string& run_directory)
+		{
+			this->memory_budget = std::max(memory_budget, min_memory_budget);
+			this->run_directory = run_directory;
+			next_run_index = 0;
+		}
+
+		bool ExternalMergeSorter::sortFile(const std::string& input_path, const std::string& output_path)
+		{
+			std::chrono::steady_clock::time_point start_time = std::chrono::steady_clock::now();
+
+			std::error_code error;
+			std::filesystem::create_directories(run_directory, error);
+
+			std::vector<std::string> run_paths;
+			if (!generateRuns(input_path, run_paths))
+			{
+				removeRuns(run_paths);
+				return false;
+			}
+			printf("Generated %zu sorted runs\n", run_paths.size());
+
+			// Merge passes until one pass can merge everything straight into the output.
+			while (run_paths.size() > max_merge_fan_in)
+			{
+				std::vector<std::string> merged_run_paths;
+				for (std::size_t first = 0; first < run_paths.size(); first += max_merge_fan_in)
+				{
+					std::vector<std::string> group(run_paths.begin() + first, run_paths.begin() + std::min(run_paths.size(), first + max_merge_fan_in));
+					merged_run_paths.push_back(createRunPath());
+
+					bool merged = mergeRuns(group, merged_run_paths.back());
+					removeRuns(group);
+					if (!merged)
+					{
+						removeRuns(merged_run_paths);
+						removeRuns(std::vector<std::string>(run_paths.begin() + first + group.size(), run_paths.end()));
+						return false;
+					}
+				}
+				run_paths.swap(merged_run_paths);
+				printf("Merged into %zu runs\n", run_paths.size());
+			}
+
+			bool merged = mergeRuns(run_paths, output_path);
+			removeRuns(run_paths);
+
+			double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+			if (merged) printf("Sorted %s into %s in %.2f s\n", input_path.c_str(), output_path.c_str(), seconds);
+			return merged;
+		}
+
+		int ExternalMergeSorter::sortFromCommandLine()
+		{
+			if (!CommandLineOptions::getOutputFile())
+			{
+				printf("--external-sort needs --output=<path>\n");
+				return 1;
+			}
+
+			Threading::NumaMemory::initializeFromCommandLine();
+			Threading::TaskScheduler::getInstance()->initialize(CommandLineOptions::getNumberOfThreads());
+			ExternalMergeSorter external_sorter(static_cast<std::size_t>(CommandLineOptions::getMemoryBudgetMiB()) << 20, "external_runs");
+			return external_sorter.sortFile(CommandLineOptions::getExternalSortInput(), CommandLineOptions::getOutputFile()) ? 0 : 1;
+		}
+
+		std::string ExternalMergeSorter::createRunPath()
+		{
+			return run_directory + "/external_run_" + std::to_string(next_run_index++) + ".bin";
+		}
+
+		// Three buffers of a third of the budget each: the run being sorted, its merge sort scratch and the
+		// previous run, which is still being written in the background.
+		bool ExternalMergeSorter::generateRuns(const std::string& input_path, std::vector<std::string>& run_paths)
+		{
+			// An empty file cannot be mapped, but it is a valid input: no runs merge into an empty output.
+			std::error_code error;
+			if (std::filesystem::is_regular_file(input_path, error) && std::filesystem::file_size(input_path, error) == 0 && !error) return true;
+
+			MemoryMappedFile input_file;
+			if (!input_file.open(input_path) || input_file.getSize() % sizeof(int) != 0)
+			{
+				printf("Cannot read %s as a binary file of 32 bit integers\n", input_path.c_str());
+				return false;
+			}
+			input_file.adviseSequentialAccess();
+
+			std::size_t value_count = input_file.getSize() / sizeof(int);
+			std::size_t run_values = std::max<std::size_t>(1, memory_budget / 3 / sizeof(int));
+			std::future<bool> pending_spill;
+			bool spilled = true;
+
+			for (std::size_t first = 0; first < value_count && spilled; first += run_values)
+			{
+				std::vector<int> run(std::min(run_values, value_count - first));
+				std::memcpy(run.data(), input_file.getData() + first * sizeof(int), run.size() * sizeof(int));
+				Sorting::parallelMergeSort(run.data(), run.size());
+
+				if (pending_spill.valid()) spilled = pending_spill.get();
+				if (!spilled) break;
+
+				run_paths.push_back(createRunPath());
+				pending_spill = ExternalRunFile::writeRunAsync(run_paths.back(), std::move(run));
+			}
+
+			if (pending_spill.valid()) spilled = pending_spill.get() && spilled;
+
+			// The arena keeps the sort scratch cached; hand it back so the merge has the whole budget.
+			HugePageArena::getInstance()->trim();
+
+			if (!spilled)
+			{
+				printf("Cannot write run files to %s\n", run_directory.c_str());
+				return false;
+			}
+			return true;
+		}
+
+		// Each run and the output get an equal share of the budget, split into two blocks for read-ahead.
+		bool ExternalMergeSorter::mergeRuns(const std::vector<std::string>& run_paths, const std::string& output_path)
+		{
+			std::size_t block_values = std::max(min_read_block_values, memory_budget / (2 * (run_paths.size() + 1)) / sizeof(int));
+
+			std::vector<ExternalRunReader> readers(run_paths.size());
+			for (std::size_t i = 0; i < run_paths.size(); i++)
+			{
+				if (readers[i].open(run_paths[i], block_values)) continue;
+
+				printf("Cannot open run %s\n", run_paths[i].c_str());
+				return false;
+			}
+
+			std::ofstream output_file(output_path, std::ios::binary | std::ios::trunc);
+			if (!output_file.is_open())
+			{
+				printf("Cannot write %s\n", output_path.c_str());
+				return false;
+			}
+
+			Sorting::LoserTree<int> run_tree(readers.size());
+			for (std::size_t i = 0; i < readers.size(); i++) if (readers[i].hasValue()) run_tree.setSource(i, readers[i].peekValue());
+			run_tree.build();
+
+			// The output is double buffered as well: one block fills while the other is written.
+			std::vector<int> output_block;
+			output_block.reserve(block_values);
+			std::future<void> pending_write;
+
+			while (!run_tree.empty())
+			{
+				std::size_t run = run_tree.winner();
+
+				output_block.push_back(run_tree.winnerKey());
+				readers[run].advance();
+				if (readers[run].hasValue()) run_tree.replaceWinner(readers[run].peekValue());
+				else run_tree.removeWinner();
+
+				if (output_block.size() < block_values && !run_tree.empty()) continue;
+
+				if (pending_write.valid()) pending_write.get();
+				pending_write = std::async(std::launch::async, [&output_file, block = std::move(output_block)]()
+					{
+						output_file.write(reinterpret_cast<const char*>(block.data()), static_cast<std::streamsize>(block.size() * sizeof(int)));
+					});
+				output_block = std::vector<int>();
+				output_block.reserve(block_values);
+			}
+
+			if (pending_write.valid()) pending_write.get();
+			return static_cast<bool>(output_file);
+		}
+
+		void ExternalMergeSorter::removeRuns(const std::vector<std::string>& run_paths)
+		{
+			std::error_code error;
+			for (const std::string& run_path : run_paths) std::filesystem::remove(run_path, error);
+		}
+	}
+}
@@ -0,0 +1,88 @@
+#include "Gameplay/Collection/ExternalRunFile.h"
+#include <algorithm>
+
+namespace Gameplay
+{
+	namespace Collection
+	{
+		namespace ExternalRunFile
+		{
+			bool writeRun(const std::string& file_path, const std::vector<int>& values)
+			{
+				std::ofstream run_file(file_path, std::ios::binary | std::ios::trunc);
+				if (!run_file.is_open()) return false;
+
+				run_file.write(reinterpret_cast<const char*>(values.data()), static_cast<std::streamsize>(values.size() * sizeof(int)));
+				return static_cast<bool>(run_file);
+			}
+
+			std::future<bool> writeRunAsync(const std::string& file_path, std::vector<int> values)
+			{
+				return std::async(std::launch::async, [file_path, values = std::move(values)]() { return writeRun(file_path, values); });
+			}
+		}
+
+		ExternalRunReader::ExternalRunReader()
+		{
+			block_values = 0;
+			read_position = 0;
+			reading_ahead = false;
+		}
+
+		ExternalRunReader::~ExternalRunReader() { close(); }
+
+		bool ExternalRunReader::open(const std::string& file_path, std::size_t block_values)
+		{
+			close();
+
+			run_file.open(file_path, std::ios::binary);
+			if (!run_file.is_open()) return false;
+
+			this->block_values = std::max<std::size_t>(block_values, 1);
+			read_position = 0;
+			readBlock(current_block);
+			startReadAhead();
+			return true;
+		}
+
+		void ExternalRunReader::close()
+		{
+			if (reading_ahead) read_ahead.wait();
+			reading_ahead = false;
+
+			if (run_file.is_open()) run_file.close();
+			current_block.clear();
+			next_block.clear();
+			read_position = 0;
+		}
+
+		std::size_t ExternalRunReader::readBlock(std::vector<int>& block)
+		{
+			block.resize(block_values);
+			run_file.read(reinterpret_cast<char*>(block.data()), static_cast<std::streamsize>(block_values * sizeof(int)));
+			block.resize(static_cast<std::size_t>(run_file.gcount()) / sizeof(int));
+			return block.size();
+		}
+
+		void ExternalRunReader::startReadAhead()
+		{
+			reading_ahead = !current_block.empty() && run_file.good();
+			if (reading_ahead) read_ahead = std::async(std::launch::async, &ExternalRunReader::readBlock, this, std::ref(next_block));
+		}
+
+		void ExternalRunReader::advance()
+		{
+			if (++read_position < current_block.size()) return;
+
+			if (reading_ahead)
+			{
+				read_ahead.get();
+				current_block.swap(next_block);
+			}
+			else current_block.clear();
+
+			read_position = 0;
+			startReadAhead();
+		}
+	}
+}
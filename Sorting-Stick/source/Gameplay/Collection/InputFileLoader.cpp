@@ -0,0 +1,237 @@
+#include "Gameplay/Collection/InputFileLoader.h"
+#include "Global/MemoryMappedFile.h"
+#include "Threading/TaskScheduler.h"
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+namespace Gameplay
+{
+	namespace Collection
+	{
+		using namespace Global;
+
+		namespace
+		{
+			const std::uint64_t repeated_ones = 0x0101010101010101ull;
+			const std::uint64_t low_seven_bits = 0x7F7F7F7F7F7F7F7Full;
+
+			// Portable population count, the compiler turns it into popcnt where available.
+			int countBits(std::uint64_t bits)
+			{
+				bits = bits - ((bits >> 1) & 0x5555555555555555ull);
+				bits = (bits & 0x3333333333333333ull) + ((bits >> 2) & 0x3333333333333333ull);
+				bits = (bits + (bits >> 4)) & 0x0F0F0F0F0F0F0F0Full;
+				return static_cast<int>((bits * repeated_ones) >> 56);
+			}
+
+			// High bit set in every byte of the word that is zero, without carries between bytes.
+			std::uint64_t markZeroBytes(std::uint64_t word)
+			{
+				return ~(((word & low_seven_bits) + low_seven_bits) | word | low_seven_bits);
+			}
+
+			std::uint64_t loadWord(const unsigned char* position)
+			{
+				std::uint64_t word;
+				std::memcpy(&word, position, sizeof(word));
+				return word;
+			}
+
+			bool isDigit(unsigned char character) { return character >= '0' && character <= '9'; }
+
+			bool isFieldEnd(unsigned char character)
+			{
+				return character == ',' || character == ';' || character == ' ' || character == '\t' || character == '\r';
+			}
+
+			// Runs chunk_function(0 .. chunk_count - 1) on the shared worker pool.
+			template<typename ChunkFunction>
+			void runOnChunks(std::size_t chunk_count, ChunkFunction chunk_function)
+			{
+				Threading::TaskScheduler::getInstance()->parallelFor(0, chunk_count, 1, [&chunk_function](std::size_t first_chunk, std::size_t last_chunk)
+					{
+						for (std::size_t i = first_chunk; i < last_chunk; i++) chunk_function(i);
+					});
+			}
+		}
+
+		bool InputFileLoader::load(const std::string& file_path, std::size_t max_values, std::vector<int>& values)
+		{
+			MemoryMappedFile input_file;
+			if (!input_file.open(file_path))
+			{
+				printf("Cannot open input file %s\n", file_path.c_str());
+				return false;
+			}
+			input_file.adviseSequentialAccess();
+
+			if (isBinaryFile(file_path)) return loadBinary(input_file.getData(), input_file.getSize(), max_values, values);
+			return loadText(input_file.getData(), input_file.getSize(), max_values, values);
+		}
+
+		bool InputFileLoader::isBinaryFile(const std::string& file_path)
+		{
+			return file_path.size() >= 4 && file_path.compare(file_path.size() - 4, 4, ".bin") == 0;
+		}
+
+		// The mapping is read as little-endian, which is every platform the game ships on.
+		bool InputFileLoader::loadBinary(const unsigned char* data, std::size_t size, std::size_t max_values, std::vector<int>& values)
+		{
+			if (size % sizeof(std::int32_t) != 0)
+			{
+				printf("Binary input size %zu is not a multiple of 4 bytes\n", size);
+				return false;
+			}
+
+			values.resize(std::min(size / sizeof(std::int32_t), max_values));
+			std::memcpy(values.data(), data, values.size() * sizeof(std::int32_t));
+			return !values.empty();
+		}
+
+		bool InputFileLoader::loadText(const unsigned char* data, std::size_t size, std::size_t max_values, std::vector<int>& values)
+		{
+			int worker_threads = Threading::TaskScheduler::getInstance()->getThreadCount();
+			std::size_t chunk_count = std::max<std::size_t>(1, std::min<std::size_t>(worker_threads, size / min_bytes_per_thread));
+
+			// Chunk boundaries move forward to the start of the next line so no number is split.
+			std::vector<const unsigned char*> chunk_begins(chunk_count + 1);
+			const unsigned char* end = data + size;
+			chunk_begins[0] = data;
+			chunk_begins[chunk_count] = end;
+			for (std::size_t i = 1; i < chunk_count; i++)
+			{
+				const unsigned char* boundary = std::max(chunk_begins[i - 1], data + size / chunk_count * i);
+				const unsigned char* line_end = static_cast<const unsigned char*>(std::memchr(boundary, '\n', end - boundary));
+				chunk_begins[i] = line_end ? line_end + 1 : end;
+			}
+
+			// First pass counts lines, an upper bound on the numbers in each chunk, so the second pass can
+			// parse every chunk straight into its own slice of the output.
+			std::vector<std::size_t> line_counts(chunk_count, 0);
+			runOnChunks(chunk_count, [&](std::size_t chunk) { line_counts[chunk] = countLines(chunk_begins[chunk], chunk_begins[chunk + 1]); });
+
+			std::size_t total_lines = 0;
+			for (std::size_t count : line_counts) total_lines += count;
+			values.resize(std::min(total_lines, max_values));
+
+			std::vector<std::size_t> chunk_offsets(chunk_count, 0);
+			std::vector<std::size_t> chunk_capacities(chunk_count, 0);
+			std::vector<std::size_t> parsed_counts(chunk_count, 0);
+			std::vector<std::size_t> skipped_lines(chunk_count, 0);
+			std::size_t value_count = 0;
+			std::size_t total_skipped_lines = 0;
+			std::size_t first_chunk = 0;
+
+			// Only the chunks whose lines reach max_values are parsed, the last one capped to the space left.
+			// Skipped lines can leave the output short, in which case the following chunks fill the rest.
+			while (first_chunk < chunk_count && value_count < values.size())
+			{
+				std::size_t last_chunk = first_chunk;
+				std::size_t offset = value_count;
+				for (; last_chunk < chunk_count && offset < values.size(); last_chunk++)
+				{
+					chunk_offsets[last_chunk] = offset;
+					chunk_capacities[last_chunk] = std::min(line_counts[last_chunk], values.size() - offset);
+					offset += chunk_capacities[last_chunk];
+				}
+
+				runOnChunks(last_chunk - first_chunk, [&](std::size_t round_chunk)
+					{
+						std::size_t chunk = first_chunk + round_chunk;
+						parsed_counts[chunk] = parseTextChunk(chunk_begins[chunk], chunk_begins[chunk + 1], values.data() + chunk_offsets[chunk], chunk_capacities[chunk], skipped_lines[chunk]);
+					});
+
+				for (std::size_t i = first_chunk; i < last_chunk; i++)
+				{
+					if (value_count != chunk_offsets[i]) std::memmove(values.data() + value_count, values.data() + chunk_offsets[i], parsed_counts[i] * sizeof(int));
+					value_count += parsed_counts[i];
+					total_skipped_lines += skipped_lines[i];
+				}
+				first_chunk = last_chunk;
+			}
+
+			if (total_skipped_lines > 0) printf("Skipped %zu lines that do not start with a 32 bit integer\n", total_skipped_lines);
+
+			values.resize(value_count);
+			values.shrink_to_fit();
+			return !values.empty();
+		}
+
+		// Counts newlines eight bytes at a time, plus one for a final line without a newline.
+		std::size_t InputFileLoader::countLines(const unsigned char* begin, const unsigned char* end)
+		{
+			const std::uint64_t newlines = repeated_ones * '\n';
+			std::size_t line_count = 0;
+			const unsigned char* position = begin;
+
+			for (; end - position >= 8; position += 8) line_count += countBits(markZeroBytes(loadWord(position) ^ newlines));
+			for (; position < end; position++) line_count += *position == '\n';
+
+			if (begin < end && end[-1] != '\n') line_count++;
+			return line_count;
+		}
+
+		std::size_t InputFileLoader::parseTextChunk(const unsigned char* begin, const unsigned char* end, int* values, std::size_t max_values, std::size_t& skipped_lines)
+		{
+			std::size_t value_count = 0;
+			const unsigned char* position = begin;
+
+			while (position < end && value_count < max_values)
+			{
+				while (position < end && (*position == ' ' || *position == '\t')) position++;
+
+				const unsigned char* line_end = static_cast<const unsigned char*>(std::memchr(position, '\n', end - position));
+				if (!line_end) line_end = end;
+
+				const unsigned char* number_end = parseNumber(position, line_end, values[value_count]);
+				if (number_end && (number_end == line_end || isFieldEnd(*number_end))) value_count++;
+				else if (position < line_end && *position != '\r') skipped_lines++;
+
+				position = line_end + 1;
+			}
+			return value_count;
+		}
+
+		// Parses an optionally signed decimal. Eight digits at a time are validated and combined with a
+		// few multiplications instead of one multiply per digit. Returns nullptr if there is no number or
+		// it does not fit in 32 bits.
+		const unsigned char* InputFileLoader::parseNumber(const unsigned char* position, const unsigned char* end, int& value)
+		{
+			bool negative = position < end && *position == '-';
+			if (position < end && (*position == '-' || *position == '+')) position++;
+
+			const unsigned char* digits_begin = position;
+			long long magnitude = 0;
+
+			if (end - position >= 8)
+			{
+				std::uint64_t word = loadWord(position);
+				bool all_digits = ((word & (repeated_ones * 0xF0)) | (((word + repeated_ones * 0x06) & (repeated_ones * 0xF0)) >> 4)) == repeated_ones * 0x33;
+				if (all_digits)
+				{
+					word -= repeated_ones * '0';
+					word = (word * 10) + (word >> 8);
+					word = (((word & 0x000000FF000000FFull) * (100 + (1000000ull << 32))) + (((word >> 16) & 0x000000FF000000FFull) * (1 + (10000ull << 32)))) >> 32;
+					magnitude = static_cast<std::uint32_t>(word);
+					position += 8;
+				}
+			}
+
+			for (; position < end && isDigit(*position); position++)
+			{
+				magnitude = magnitude * 10 + (*position - '0');
+				if (magnitude > static_cast<long long>(INT_MAX) + 1) return nullptr;
+			}
+
+			if (position == digits_begin) return nullptr;
+			if (negative) magnitude = -magnitude;
+			if (magnitude > INT_MAX || magnitude < INT_MIN) return nullptr;
+
+			value = static_cast<int>(magnitude);
+			return position;
+		}
+	}
+}
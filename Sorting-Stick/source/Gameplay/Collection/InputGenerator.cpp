@@ -0,0 +1,155 @@
+#include "Gameplay/Collection/InputGenerator.h"
+#include "Threading/TaskScheduler.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+namespace Gameplay
+{
+	namespace Collection
+	{
+		InputGenerator::InputGenerator(InputDistribution distribution, std::uint64_t seed, int number_of_values)
+		{
+			this->distribution = distribution;
+			this->seed = seed;
+			this->number_of_values = std::max(number_of_values, 1);
+
+			// Smallest power of two domain that holds every index, split into two halves that may differ by a
+			// bit. Cycle walking in permuteIndex skips the values past the end, fewer than two passes on average.
+			int index_bits = 2;
+			while ((1ull << index_bits) < static_cast<std::uint64_t>(this->number_of_values)) index_bits++;
+
+			permutation_left_bits = index_bits / 2;
+			permutation_right_bits = index_bits - permutation_left_bits;
+			for (int i = 0; i < permutation_rounds; i++) permutation_round_keys[i] = mixBits(seed ^ (0xA0761D6478BD642Full * (i + 1)));
+		}
+
+		// SplitMix64 output function.
+		std::uint64_t InputGenerator::mixBits(std::uint64_t bits)
+		{
+			bits = (bits ^ (bits >> 30)) * 0xBF58476D1CE4E5B9ull;
+			bits = (bits ^ (bits >> 27)) * 0x94D049BB133111EBull;
+			return bits ^ (bits >> 31);
+		}
+
+		// The state SplitMix64 would reach after (index * 2 + stream + 1) steps, computed directly.
+		std::uint64_t InputGenerator::randomBits(int index, int stream) const
+		{
+			std::uint64_t counter = static_cast<std::uint64_t>(index) * 2 + stream + 1;
+			return mixBits(seed + counter * 0x9E3779B97F4A7C15ull);
+		}
+
+		// Uniform in (0, 1].
+		double InputGenerator::randomUnit(int index, int stream) const
+		{
+			return static_cast<double>((randomBits(index, stream) >> 11) + 1) * (1.0 / 9007199254740992.0);
+		}
+
+		std::uint64_t InputGenerator::permuteIndex(std::uint64_t index) const
+		{
+			do
+			{
+				int left_bits = permutation_left_bits;
+				int right_bits = permutation_right_bits;
+				std::uint64_t left = index >> right_bits;
+				std::uint64_t right = index & ((1ull << right_bits) - 1);
+
+				// Unbalanced Feistel rounds: the halves trade places, and widths, every round.
+				for (int i = 0; i < permutation_rounds; i++)
+				{
+					std::uint64_t next_right = left ^ (mixBits(right ^ permutation_round_keys[i]) & ((1ull << left_bits) - 1));
+					left = right;
+					right = next_right;
+					std::swap(left_bits, right_bits);
+				}
+
+				index = (left << right_bits) | right;
+			} while (index >= static_cast<std::uint64_t>(number_of_values));
+
+			return index;
+		}
+
+		int InputGenerator::clampValue(long long value) const
+		{
+			return static_cast<int>(std::max(0ll, std::min(value, static_cast<long long>(number_of_values) - 1)));
+		}
+
+		int InputGenerator::valueAt(int index) const
+		{
+			long long n = number_of_values;
+
+			switch (distribution)
+			{
+			case InputDistribution::RANDOM:
+				return static_cast<int>(permuteIndex(static_cast<std::uint64_t>(index)));
+
+			case InputDistribution::SORTED:
+				return index;
+
+			case InputDistribution::REVERSED:
+				return static_cast<int>(n - 1 - index);
+
+			case InputDistribution::FEW_UNIQUE:
+			{
+				long long level = static_cast<long long>(randomBits(index, 0) % few_unique_levels);
+				return clampValue((2 * level + 1) * n / (2 * few_unique_levels));
+			}
+
+			case InputDistribution::ORGAN_PIPE:
+				return index < (n + 1) / 2 ? 2 * index : static_cast<int>(2 * (n - 1 - index) + 1);
+
+			case InputDistribution::SAWTOOTH:
+			{
+				long long tooth_length = (n + sawtooth_teeth - 1) / sawtooth_teeth;
+				return clampValue((index % tooth_length) * n / tooth_length);
+			}
+
+			case InputDistribution::GAUSSIAN:
+			{
+				// Box-Muller transform of two independent uniforms.
+				double radius = std::sqrt(-2.0 * std::log(randomUnit(index, 0)));
+				double normal = radius * std::cos(6.283185307179586 * randomUnit(index, 1));
+				return clampValue(std::llround(n * 0.5 + normal * n / gaussian_spread_divisor));
+			}
+
+			case InputDistribution::NEARLY_SORTED:
+			{
+				std::uint64_t bits = randomBits(index, 0);
+				if (bits % nearly_sorted_period != 0) return index;
+
+				long long window = std::max(1ll, n / nearly_sorted_window_divisor);
+				long long offset = static_cast<long long>((bits >> 32) % (2 * window + 1)) - window;
+				return clampValue(index + offset);
+			}
+
+			default:
+				break;
+			}
+			return index;
+		}
+
+		void InputGenerator::fill(const std::function<void(int first_index, int last_index)>& fill_range) const
+		{
+			if (number_of_values <= 0) return;
+
+			Threading::TaskScheduler::getInstance()->parallelFor(0, number_of_values, min_values_per_thread,
+				[&fill_range](std::size_t first_index, std::size_t last_index)
+				{
+					fill_range(static_cast<int>(first_index), static_cast<int>(last_index));
+				});
+		}
+
+		bool InputGenerator::parseDistribution(const char* option_name, InputDistribution& distribution)
+		{
+			for (int i = 0; i < static_cast<int>(InputDistribution::COUNT); i++)
+			{
+				if (std::strcmp(option_name, getInputDistributionOptionName(static_cast<InputDistribution>(i))) != 0) continue;
+
+				distribution = static_cast<InputDistribution>(i);
+				return true;
+			}
+			return false;
+		}
+	}
+}
@@ -0,0 +1,270 @@
+#include "Gameplay/Collection/OperationTraceReader.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <utility>
+
+namespace Gameplay
+{
+	namespace Collection
+	{
+		OperationTraceReader::OperationTraceReader()
+		{
+			operations_begin = nullptr;
+			operations_end = nullptr;
+			sort_type = 0;
+			operation_count = 0;
+			snapshot_stride = 1;
+			cursor = nullptr;
+			previous_index = 0;
+			position = 0;
+			comparisons = 0;
+			array_accesses = 0;
+			last_operation = { OperationType::COMPARE, 0, 0 };
+		}
+
+		OperationTraceReader::~OperationTraceReader() { close(); }
+
+		bool OperationTraceReader::open(const std::string& file_path)
+		{
+			close();
+
+			if (!trace_file.open(file_path))
+			{
+				printf("Error opening operation trace %s\n", file_path.c_str());
+				return false;
+			}
+
+			const unsigned char* input = trace_file.getData();
+			const unsigned char* end = input + trace_file.getSize();
+			std::uint64_t version = 0, type = 0, element_count = 0;
+
+			if (trace_file.getSize() < 4 || std::memcmp(input, OperationTrace::magic, 4) != 0 ||
+				!(input = OperationTrace::readVarint(input + 4, end, version)) || version != OperationTrace::version ||
+				!(input = OperationTrace::readVarint(input, end, type)) ||
+				!(input = OperationTrace::readVarint(input, end, element_count)) || element_count > static_cast<std::uint64_t>(end - input))
+			{
+				printf("Invalid operation trace %s\n", file_path.c_str());
+				close();
+				return false;
+			}
+
+			sort_type = static_cast<int>(type);
+			values.resize(static_cast<std::size_t>(element_count));
+
+			for (int& value : values)
+			{
+				std::uint64_t encoded;
+				if (!(input = OperationTrace::readVarint(input, end, encoded)))
+				{
+					printf("Truncated operation trace %s\n", file_path.c_str());
+					close();
+					return false;
+				}
+				value = static_cast<int>(OperationTrace::decodeZigZag(encoded));
+			}
+
+			operations_begin = input;
+			operations_end = end;
+			buildKeyframes();
+			return true;
+		}
+
+		void OperationTraceReader::close()
+		{
+			trace_file.close();
+			operations_begin = nullptr;
+			operations_end = nullptr;
+			operation_count = 0;
+			keyframes.clear();
+			undo_entries.clear();
+			snapshots.clear();
+			values.clear();
+			cursor = nullptr;
+			position = 0;
+		}
+
+		bool OperationTraceReader::decodeOperation(const unsigned char*& input, std::int64_t& last_index, TraceOperation& operation) const
+		{
+			if (input >= operations_end || *input > static_cast<unsigned char>(OperationType::WRITE)) return false;
+
+			const unsigned char* next = input + 1;
+			std::uint64_t first_delta, second;
+			if (!(next = OperationTrace::readVarint(next, operations_end, first_delta))) return false;
+			if (!(next = OperationTrace::readVarint(next, operations_end, second))) return false;
+
+			std::int64_t first_index = last_index + OperationTrace::decodeZigZag(first_delta);
+			std::int64_t second_value = OperationTrace::decodeZigZag(second);
+			operation.type = static_cast<OperationType>(*input);
+
+			if (operation.type != OperationType::WRITE) second_value += first_index;
+
+			std::int64_t element_count = static_cast<std::int64_t>(values.size());
+			if (first_index < 0 || first_index >= element_count) return false;
+			if (operation.type != OperationType::WRITE && (second_value < 0 || second_value >= element_count)) return false;
+
+			operation.first_index = static_cast<int>(first_index);
+			operation.second = static_cast<int>(second_value);
+			last_index = first_index;
+			input = next;
+			return true;
+		}
+
+		void OperationTraceReader::applyOperation(const TraceOperation& operation)
+		{
+			switch (operation.type)
+			{
+			case OperationType::COMPARE:
+				comparisons++;
+				array_accesses += 2;
+				break;
+			case OperationType::SWAP:
+				std::swap(values[operation.first_index], values[operation.second]);
+				array_accesses += 4;
+				break;
+			case OperationType::WRITE:
+				values[operation.first_index] = operation.second;
+				array_accesses++;
+				break;
+			}
+
+			last_operation = operation;
+			position++;
+		}
+
+		// Restores the decoder state of a keyframe; the values must already match it.
+		void OperationTraceReader::restoreKeyframe(std::uint64_t keyframe_index)
+		{
+			const Keyframe& keyframe = keyframes[static_cast<std::size_t>(keyframe_index)];
+			cursor = operations_begin + keyframe.byte_offset;
+			previous_index = keyframe.previous_index;
+			comparisons = keyframe.comparisons;
+			array_accesses = keyframe.array_accesses;
+			last_operation = keyframe.last_operation;
+			position = keyframe_index * keyframe_interval;
+		}
+
+		// Elements the interval never touches already hold their keyframe values, so writing back the
+		// touched ones returns any state inside the interval, or at its end, to the keyframe.
+		void OperationTraceReader::undoInterval(std::uint64_t keyframe_index)
+		{
+			std::size_t undo_begin = keyframes[static_cast<std::size_t>(keyframe_index)].undo_begin;
+			std::size_t undo_end = keyframes[static_cast<std::size_t>(keyframe_index) + 1].undo_begin;
+			for (std::size_t i = undo_begin; i < undo_end; i++) values[undo_entries[i].index] = undo_entries[i].value;
+		}
+
+		void OperationTraceReader::stepForward(std::uint64_t operation_index)
+		{
+			TraceOperation operation;
+			while (position < operation_index && decodeOperation(cursor, previous_index, operation)) applyOperation(operation);
+		}
+
+		// The first pass only counts valid operations so the snapshot spacing can be chosen to fit the
+		// budget; the second pass replays everything once and records the keyframes, undo diffs and
+		// snapshots. An undo diff holds each touched element once, with its value at the keyframe.
+		void OperationTraceReader::buildKeyframes()
+		{
+			operation_count = 0;
+			const unsigned char* input = operations_begin;
+			std::int64_t last_index = 0;
+			TraceOperation operation;
+			while (decodeOperation(input, last_index, operation)) operation_count++;
+			operations_end = input;
+
+			std::uint64_t keyframe_count = operation_count / keyframe_interval + 1;
+			std::uint64_t snapshot_bytes = std::max<std::uint64_t>(1, values.size() * sizeof(int));
+			std::uint64_t max_snapshots = std::max<std::uint64_t>(1, max_snapshot_bytes / snapshot_bytes);
+			snapshot_stride = (keyframe_count + max_snapshots - 1) / max_snapshots;
+
+			cursor = operations_begin;
+			previous_index = 0;
+			position = 0;
+			comparisons = 0;
+			array_accesses = 0;
+			last_operation = { OperationType::COMPARE, 0, 0 };
+
+			keyframes.clear();
+			keyframes.reserve(static_cast<std::size_t>(keyframe_count + 1));
+			undo_entries.clear();
+			snapshots.clear();
+
+			std::vector<std::uint64_t> touched_interval(values.size(), 0); // interval + 1 that last saved the element
+			auto saveOldValue = [&](int index)
+				{
+					std::uint64_t interval = position / keyframe_interval + 1;
+					if (touched_interval[index] == interval) return;
+					touched_interval[index] = interval;
+					undo_entries.push_back({ index, values[index] });
+				};
+
+			while (true)
+			{
+				if (position % keyframe_interval == 0)
+				{
+					keyframes.push_back({ static_cast<std::size_t>(cursor - operations_begin), previous_index, comparisons, array_accesses, last_operation, undo_entries.size() });
+					if ((keyframes.size() - 1) % snapshot_stride == 0) snapshots.push_back(values);
+				}
+
+				if (!decodeOperation(cursor, previous_index, operation)) break;
+				if (operation.type == OperationType::SWAP)
+				{
+					saveOldValue(operation.first_index);
+					saveOldValue(operation.second);
+				}
+				else if (operation.type == OperationType::WRITE) saveOldValue(operation.first_index);
+				applyOperation(operation);
+			}
+
+			// Closes the undo diff of the last, possibly partial, interval.
+			keyframes.push_back({ 0, 0, 0, 0, last_operation, undo_entries.size() });
+			undo_entries.shrink_to_fit();
+
+			values = snapshots.front();
+			restoreKeyframe(0);
+		}
+
+		// Moves by whichever is cheaper: undo diffs back to the target's keyframe (backwards only) or
+		// decoding from the current state (forwards only), against a copy of the nearest snapshot at or
+		// before the target followed by decoding.
+		void OperationTraceReader::seek(std::uint64_t operation_index)
+		{
+			if (!isOpen()) return;
+
+			operation_index = std::min(operation_index, operation_count);
+			if (operation_index == position) return;
+
+			std::uint64_t target_keyframe = operation_index / keyframe_interval;
+			std::uint64_t snapshot_index = target_keyframe / snapshot_stride;
+			std::uint64_t snapshot_keyframe = snapshot_index * snapshot_stride;
+			std::uint64_t snapshot_cost = values.size() + (operation_index - snapshot_keyframe * keyframe_interval);
+
+			if (operation_index > position)
+			{
+				if (operation_index - position > snapshot_cost && snapshot_keyframe * keyframe_interval > position)
+				{
+					values = snapshots[static_cast<std::size_t>(snapshot_index)];
+					restoreKeyframe(snapshot_keyframe);
+				}
+				stepForward(operation_index);
+				return;
+			}
+
+			// A position between keyframes first undoes its own interval.
+			std::uint64_t undo_from = (position + keyframe_interval - 1) / keyframe_interval;
+			std::uint64_t undo_cost = keyframes[static_cast<std::size_t>(undo_from)].undo_begin - keyframes[static_cast<std::size_t>(target_keyframe)].undo_begin
+				+ (operation_index - target_keyframe * keyframe_interval);
+
+			if (undo_cost <= snapshot_cost)
+			{
+				for (std::uint64_t keyframe_index = undo_from; keyframe_index > target_keyframe; keyframe_index--) undoInterval(keyframe_index - 1);
+				restoreKeyframe(target_keyframe);
+			}
+			else
+			{
+				values = snapshots[static_cast<std::size_t>(snapshot_index)];
+				restoreKeyframe(snapshot_keyframe);
+			}
+			stepForward(operation_index);
+		}
+	}
+}
@@ -0,0 +1,120 @@
+#include "Gameplay/Collection/OperationTraceWriter.h"
+#include <cstdio>
+
+namespace Gameplay
+{
+	namespace Collection
+	{
+		OperationTraceWriter::OperationTraceWriter()
+		{
+			recording = false;
+			active_block = 0;
+			write_position = 0;
+			previous_index = 0;
+			pending_block = -1;
+			pending_size = 0;
+			stop_writer = false;
+			operations_recorded = 0;
+			bytes_written = 0;
+		}
+
+		OperationTraceWriter::~OperationTraceWriter() { endTrace(); }
+
+		bool OperationTraceWriter::beginTrace(const std::string& file_path, int sort_type, const std::vector<int>& initial_values)
+		{
+			endTrace();
+
+			trace_file.open(file_path, std::ios::binary | std::ios::trunc);
+			if (!trace_file.is_open())
+			{
+				printf("Error opening operation trace %s\n", file_path.c_str());
+				return false;
+			}
+
+			for (int i = 0; i < 2; i++) blocks[i].resize(block_size);
+			active_block = 0;
+			write_position = 0;
+			previous_index = 0;
+			pending_block = -1;
+			stop_writer = false;
+			operations_recorded = 0;
+			bytes_written = 0;
+
+			// The header goes through the blocks like everything else; large arrays simply span several blocks.
+			unsigned char* output = blocks[0].data();
+			for (int i = 0; i < 4; i++) *output++ = static_cast<unsigned char>(OperationTrace::magic[i]);
+			output = OperationTrace::writeVarint(output, OperationTrace::version);
+			output = OperationTrace::writeVarint(output, static_cast<std::uint64_t>(sort_type));
+			output = OperationTrace::writeVarint(output, initial_values.size());
+			write_position = output - blocks[0].data();
+
+			writer_thread = std::thread(&OperationTraceWriter::runWriterThread, this);
+			recording = true;
+
+			for (int value : initial_values)
+			{
+				if (write_position + OperationTrace::max_varint_bytes > block_size) submitActiveBlock();
+
+				unsigned char* start = blocks[active_block].data() + write_position;
+				write_position += OperationTrace::writeVarint(start, OperationTrace::encodeZigZag(value)) - start;
+			}
+
+			return true;
+		}
+
+		void OperationTraceWriter::endTrace()
+		{
+			if (!recording) return;
+
+			submitActiveBlock();
+			{
+				std::unique_lock<std::mutex> lock(block_mutex);
+				stop_writer = true;
+			}
+			block_condition.notify_all();
+			writer_thread.join();
+
+			trace_file.close();
+			recording = false;
+
+			printf("Recorded %llu operations in %llu bytes\n", static_cast<unsigned long long>(operations_recorded), static_cast<unsigned long long>(bytes_written));
+		}
+
+		// Hands the filled block to the writer thread; only waits if the writer is still busy with the other one.
+		void OperationTraceWriter::submitActiveBlock()
+		{
+			std::unique_lock<std::mutex> lock(block_mutex);
+			block_condition.wait(lock, [this] { return pending_block == -1; });
+
+			pending_block = active_block;
+			pending_size = write_position;
+			lock.unlock();
+			block_condition.notify_all();
+
+			active_block ^= 1;
+			write_position = 0;
+		}
+
+		void OperationTraceWriter::runWriterThread()
+		{
+			std::unique_lock<std::mutex> lock(block_mutex);
+
+			while (true)
+			{
+				block_condition.wait(lock, [this] { return pending_block != -1 || stop_writer; });
+				if (pending_block == -1) return;
+
+				int block = pending_block;
+				std::size_t size = pending_size;
+
+				lock.unlock();
+				trace_file.write(reinterpret_cast<const char*>(blocks[block].data()), static_cast<std::streamsize>(size));
+				lock.lock();
+
+				bytes_written += size;
+				pending_block = -1;
+				block_condition.notify_all();
+			}
+		}
+	}
+}
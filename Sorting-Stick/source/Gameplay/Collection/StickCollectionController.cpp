@@ -4,8 +4,20 @@
 #include "Gameplay/GameplayService.h"
 #include "Global/ServiceLocator.h"
 #include "Gameplay/Collection/Stick.h"
+#include "Gameplay/Collection/OperationTraceWriter.h"
+#include "Gameplay/Collection/OperationTraceReader.h"
+#include "Gameplay/Collection/InputGenerator.h"
+#include "Gameplay/Collection/InputFileLoader.h"
+#include "Gameplay/Collection/ExternalRunFile.h"
+#include "Profiling/TraceRecorder.h"
+#include "Sorting/KeyTraits.h"
+#include "Sorting/LoserTree.h"
+#include "Sorting/StabilityCheck.h"
+#include "Threading/NumaMemory.h"
 #include <random>
 #include <iostream>
+#include <filesystem>
+#include <future>
 
 namespace Gameplay
 {
@@ -15,12 +27,35 @@ namespace Gameplay
 		using namespace Global;
 		using namespace Graphics;
 
+		int StickCollectionController::next_operation_trace_index = 0;
+		std::atomic<int> StickCollectionController::next_external_sort_index(0);
+
 		StickCollectionController::StickCollectionController()
 		{
 			collection_view = new StickCollectionView();
 			collection_model = new StickCollectionModel();
-
-			for (int i = 0; i < collection_model->number_of_elements; i++) sticks.push_back(new Stick(i));
+			operation_trace_writer = new OperationTraceWriter();
+			operation_trace_reader = new OperationTraceReader();
+			replay_position = 0;
+			replay_speed = 1.f;
+			replay_direction = 1;
+			sort_type = SortType::BUBBLE_SORT;
+			sort_state = SortState::NOT_SORTING;
+			sort_thread_finished = false;
+			sort_completed = false;
+			stability_check = Sorting::StabilityCheck::NOT_CHECKED;
+			finish_place = 0;
+			undo_begin = 0;
+			undo_count = 0;
+			undo_position = 0;
+			undo_recording = false;
+			sort_paused = false;
+			pending_steps = 0;
+			sort_thread_waiting = false;
+			file_input_min_value = 0;
+			file_input_max_value = 0;
+
+			createSticks();
 		}
 
 		StickCollectionController::~StickCollectionController()
@@ -31,86 +66,537 @@ namespace Gameplay
 		void StickCollectionController::initialize()
 		{
 			sort_state = SortState::NOT_SORTING;
-			collection_view->initialize(this);
-			initializeSticks();
+			collection_view->initialize(this, collection_model);
+
+			float window_width = static_cast<float>(ServiceLocator::getInstance()->getGraphicService()->getGameWindow()->getSize().x);
+			collection_model->lane_bounds = sf::FloatRect(0.f, collection_model->element_y_position - collection_model->max_element_height, window_width, collection_model->max_element_height);
+
 			reset();
 		}
 
 		void StickCollectionController::update()
 		{
-			processSortThreadState();
+			if (ServiceLocator::getInstance()->getEventService()->pressedF7Key()) toggleOperationTrace();
+			if (ServiceLocator::getInstance()->getEventService()->pressedF8Key()) toggleReplay();
+			if (ServiceLocator::getInstance()->getEventService()->pressedF6Key() && sort_state == SortState::NOT_SORTING) cycleInputDistribution();
+			if (ServiceLocator::getInstance()->getEventService()->pressedF5Key() && sort_state == SortState::NOT_SORTING) toggleStableSortMode();
+
+			if (sort_state == SortState::REPLAYING) updateReplay();
+			else
+			{
+				if (sort_state == SortState::SORTING) processStepInput();
+				processSortThreadState();
+			}
 			collection_view->update();
-			for (int i = 0; i < sticks.size(); i++) sticks[i]->stick_view->update();
 		}
 
 		void StickCollectionController::render()
 		{
 			collection_view->render();
-			for (int i = 0; i < sticks.size(); i++) sticks[i]->stick_view->render();
+			collection_view->renderSticks(sticks);
+		}
+
+		void StickCollectionController::renderLaneLabel()
+		{
+			collection_view->render();
+		}
+
+		void StickCollectionController::prepareStickVertices()
+		{
+			collection_view->updateStickVertices(sticks);
+		}
+
+		void StickCollectionController::appendSticksToBatch(sf::VertexArray& stick_batch)
+		{
+			collection_view->appendStickVerticesToBatch(stick_batch);
+		}
+
+		void StickCollectionController::setRaceLaneIndex(int race_lane_index)
+		{
+			collection_model->race_lane_index = race_lane_index;
+		}
+
+		void StickCollectionController::setLaneBounds(sf::FloatRect lane_bounds)
+		{
+			collection_model->lane_bounds = lane_bounds;
+			collection_view->setLaneLabelPosition(sf::Vector2f(lane_bounds.left + collection_model->lane_label_offset.x, lane_bounds.top + collection_model->lane_label_offset.y));
+		}
+
+		// The sticks live in one contiguous array that is only reallocated when it has to grow.
+		void StickCollectionController::createSticks()
+		{
+			sticks.resize(collection_model->number_of_elements);
+			for (int i = 0; i < sticks.size(); i++) sticks[i] = Stick(i, collection_model->element_color, i);
+		}
+
+		void StickCollectionController::setNumberOfElements(int number_of_elements)
+		{
+			if (sort_state == SortState::SORTING) reset();
+
+			number_of_elements = std::max(collection_model->min_number_of_elements, std::min(number_of_elements, collection_model->max_number_of_elements));
+			if (number_of_elements == collection_model->number_of_elements) return;
+
+			file_input_values.reset();
+			collection_model->number_of_elements = number_of_elements;
+			createSticks();
+			reset();
+		}
+
+		// Keeps a run of the default 30 sticks at the original pace and scales the delay down with the element count.
+		int StickCollectionController::calculateOperationDelay()
+		{
+			long long scaled_delay = collection_model->operation_delay * collection_model->delay_reference_elements / collection_model->number_of_elements;
+			return static_cast<int>(std::min<long long>(scaled_delay, collection_model->operation_delay));
+		}
+
+		void StickCollectionController::sleepForOperationDelay(int delay_in_ms)
+		{
+			if (delay_in_ms > 0) std::this_thread::sleep_for(std::chrono::milliseconds(delay_in_ms));
+		}
+
+		void StickCollectionController::generateInputValues()
+		{
+			if (file_input_values)
+			{
+				for (int i = 0; i < sticks.size(); i++)
+				{
+					sticks[i].data = (*file_input_values)[i];
+					sticks[i].original_index = i;
+				}
+				setValueRange(file_input_min_value, file_input_max_value);
+				return;
+			}
+
+			if (!collection_model->fixed_input_seed)
+			{
+				std::random_device device;
+				collection_model->input_seed = (static_cast<std::uint64_t>(device()) << 32) | device();
+			}
+
+			InputGenerator generator(collection_model->input_distribution, collection_model->input_seed, static_cast<int>(sticks.size()));
+			generator.fill([this, &generator](int first_index, int last_index)
+				{
+					for (int i = first_index; i < last_index; i++)
+					{
+						sticks[i].data = generator.valueAt(i);
+						sticks[i].original_index = i;
+					}
+				});
+			setValueRange(0, static_cast<int>(sticks.size()) - 1);
+		}
+
+		void StickCollectionController::setValueRange(int min_value, int max_value)
+		{
+			collection_model->min_value = min_value;
+			collection_model->max_value = max_value;
+		}
+
+		void StickCollectionController::cycleInputDistribution()
+		{
+			int next_distribution = (static_cast<int>(collection_model->input_distribution) + 1) % static_cast<int>(InputDistribution::COUNT);
+			file_input_values.reset();
+			setInputDistribution(static_cast<InputDistribution>(next_distribution));
+			reset();
+
+			printf("Input distribution : %s\n", getInputDistributionName(collection_model->input_distribution));
+		}
+
+		void StickCollectionController::toggleStableSortMode()
+		{
+			setStableSortMode(!collection_model->stable_sort_mode);
+			printf("Stable sort mode : %s\n", collection_model->stable_sort_mode ? "on" : "off");
 		}
-		void StickCollectionController::initializeSticks()
+
+		// Takes effect on the next sort.
+		void StickCollectionController::setStableSortMode(bool stable_sort_mode)
 		{
-			float rectangle_width = calculateStickWidth();
+			collection_model->stable_sort_mode = stable_sort_mode;
+		}
 
-			for (int i = 0; i < collection_model->number_of_elements; i++)
+		// Takes effect on the next reset.
+		void StickCollectionController::setInputDistribution(InputDistribution distribution)
+		{
+			collection_model->input_distribution = distribution;
+		}
+
+		// Pins the seed so every following reset produces the same input; takes effect on the next reset.
+		void StickCollectionController::setInputSeed(std::uint64_t seed)
+		{
+			collection_model->input_seed = seed;
+			collection_model->fixed_input_seed = true;
+		}
+
+		bool StickCollectionController::loadInputFile(const std::string& file_path)
+		{
+			std::shared_ptr<std::vector<int>> input_values = std::make_shared<std::vector<int>>();
+			if (!InputFileLoader::load(file_path, collection_model->max_number_of_elements, *input_values)) return false;
+
+			printf("Loaded %zu keys from %s\n", input_values->size(), file_path.c_str());
+			setInputValues(input_values);
+			return true;
+		}
+
+		// The element count follows the loaded keys, also below min_number_of_elements.
+		void StickCollectionController::setInputValues(std::shared_ptr<const std::vector<int>> input_values)
+		{
+			if (sort_state == SortState::SORTING) reset();
+
+			file_input_values = input_values;
+			std::pair<std::vector<int>::const_iterator, std::vector<int>::const_iterator> value_range = std::minmax_element(input_values->begin(), input_values->end());
+			file_input_min_value = *value_range.first;
+			file_input_max_value = *value_range.second;
+
+			collection_model->number_of_elements = static_cast<int>(input_values->size());
+			createSticks();
+			reset();
+		}
+
+		std::shared_ptr<const std::vector<int>> StickCollectionController::getInputValues() { return file_input_values; }
+
+		void StickCollectionController::playCompareSound(int array_position)
+		{
+			if (collection_model->number_of_elements > collection_model->max_sonified_elements) return;
+
+			// Pitch is relative to the key range, scaled to the element count so generated inputs sound as before.
+			long long value_range = static_cast<long long>(collection_model->max_value) - collection_model->min_value;
+			long long value_offset = static_cast<long long>(sticks[array_position].data) - collection_model->min_value;
+			int pitch_position = value_range > 0 ? static_cast<int>(value_offset * (collection_model->number_of_elements - 1) / value_range) : 0;
+
+			ServiceLocator::getInstance()->getSoundService()->playCompareSound(pitch_position, collection_model->number_of_elements - 1);
+		}
+
+		bool StickCollectionController::compareSticksByData(const Stick& a, const Stick& b) const
+		{
+			return Sorting::KeyTraits<Stick::Key>::less(a.data, b.data);
+		}
+
+		// In stable sort mode equal keys are ordered by input position, which makes any sort stable.
+		bool StickCollectionController::compareSticksByOrder(const Stick& a, const Stick& b) const
+		{
+			if (!collection_model->stable_sort_mode) return compareSticksByData(a, b);
+			if (compareSticksByData(a, b)) return true;
+			return !compareSticksByData(b, a) && a.original_index < b.original_index;
+		}
+
+		// One pass over the (key, original index) pairs without allocating. The selection modes only
+		// order part of the sticks, so the rest is checked against the boundary of the ordered part.
+		Sorting::StabilityCheck StickCollectionController::checkStability() const
+		{
+			auto less = [this](const Stick& a, const Stick& b) { return compareSticksByData(a, b); };
+			auto index_of = [](const Stick& stick) { return stick.original_index; };
+			int number_of_sticks = static_cast<int>(sticks.size());
+			int selection_count = getSelectionCount();
+
+			switch (sort_type)
 			{
-				float rectangle_height = calculateStickHeight(i);
+			case SortType::PARTIAL_SORT:
+				for (int i = selection_count; i < number_of_sticks; i++) if (less(sticks[i], sticks[selection_count - 1])) return Sorting::StabilityCheck::NOT_SORTED;
+				return Sorting::checkStableOrder(sticks.data(), selection_count, less, index_of);
 
-				sf::Vector2f rectangle_size = sf::Vector2f(rectangle_width, rectangle_height);
+			case SortType::TOP_K:
+				for (int i = 0; i < number_of_sticks - selection_count; i++) if (less(sticks[number_of_sticks - selection_count], sticks[i])) return Sorting::StabilityCheck::NOT_SORTED;
+				return Sorting::checkStableOrder(sticks.data() + number_of_sticks - selection_count, selection_count, less, index_of);
 
-				sticks[i]->stick_view->initialize(rectangle_size, sf::Vector2f(0, 0), 0, collection_model->element_color);
+			case SortType::NTH_ELEMENT:
+			{
+				int nth = number_of_sticks / 2;
+				for (int i = 0; i < nth; i++) if (less(sticks[nth], sticks[i])) return Sorting::StabilityCheck::NOT_SORTED;
+				for (int i = nth + 1; i < number_of_sticks; i++) if (less(sticks[i], sticks[nth])) return Sorting::StabilityCheck::NOT_SORTED;
+				return Sorting::StabilityCheck::PARTITIONED;
+			}
 
+			default:
+				return Sorting::checkStableOrder(sticks.data(), sticks.size(), less, index_of);
 			}
 		}
-		float StickCollectionController::calculateStickWidth()
+
+		int StickCollectionController::getSelectionCount() const
+		{
+			int number_of_sticks = static_cast<int>(sticks.size());
+			return std::max(1, std::min(number_of_sticks, static_cast<int>(number_of_sticks * collection_model->selection_fraction)));
+		}
+
+		void StickCollectionController::recordComparison(int first_index, int second_index)
 		{
-			float total_space = static_cast<float>(ServiceLocator::getInstance()->getGraphicService()->getGameWindow()->getSize().x);
+			waitForStep();
+			operation_trace_writer->recordComparison(first_index, second_index);
+		}
 
-			float total_spacing = collection_model->space_percentage * total_space;
+		void StickCollectionController::swapSticks(int first_index, int second_index)
+		{
+			waitForStep();
+			std::swap(sticks[first_index], sticks[second_index]);
+			pushUndoEntry({ OperationType::SWAP, first_index, second_index, Stick(), Stick() });
+			operation_trace_writer->recordSwap(first_index, second_index);
+		}
 
-			float space_between = total_spacing / (collection_model->number_of_elements - 1);
-			collection_model->setElementSpacing(space_between);
+		void StickCollectionController::writeStick(int array_position, const Stick& stick)
+		{
+			waitForStep();
+			pushUndoEntry({ OperationType::WRITE, array_position, 0, sticks[array_position], stick });
+			sticks[array_position] = stick;
+			operation_trace_writer->recordWrite(array_position, stick.data);
+		}
 
-			float remaining_space = total_space - total_spacing;
+		// Nothing is logged until the sort is first paused. After that only the newest max_undo_entries
+		// operations can be stepped back: a full ring overwrites its oldest entry.
+		void StickCollectionController::pushUndoEntry(const UndoEntry& entry)
+		{
+			if (!undo_recording) return;
+			if (undo_log.empty()) undo_log.resize(collection_model->max_undo_entries);
 
-			float rectangle_width = remaining_space / collection_model->number_of_elements;
+			if (undo_count < undo_log.size()) undo_count++;
+			else undo_begin = (undo_begin + 1) % undo_log.size();
 
-			return rectangle_width;
+			getUndoEntry(undo_count - 1) = entry;
+			undo_position = undo_count;
 		}
-		void StickCollectionController::updateStickPosition()
+
+		StickCollectionController::UndoEntry& StickCollectionController::getUndoEntry(std::size_t position)
 		{
-			for (int i = 0; i < sticks.size(); i++)
+			return undo_log[(undo_begin + position) % undo_log.size()];
+		}
+
+		void StickCollectionController::clearUndoLog()
+		{
+			undo_recording = false;
+			undo_begin = 0;
+			undo_count = 0;
+			undo_position = 0;
+		}
+
+		// Called by the sort thread before every operation. While paused it parks here until the main
+		// thread grants a step, so the main thread may touch sticks and the undo log whenever it is parked.
+		void StickCollectionController::waitForStep()
+		{
+			if (!sort_paused) return;
+
+			std::unique_lock<std::mutex> lock(step_mutex);
+			sort_thread_waiting = true;
+			step_condition.wait(lock, [this] { return !sort_paused || pending_steps > 0; });
+
+			if (sort_paused) pending_steps--;
+			sort_thread_waiting = false;
+		}
+
+		void StickCollectionController::processStepInput()
+		{
+			Event::EventService* event_service = ServiceLocator::getInstance()->getEventService();
+
+			if (event_service->pressedSpaceKey()) togglePause();
+			if (!sort_paused) return;
+
+			if (event_service->pressedRightArrowKey()) stepForward();
+			if (event_service->pressedLeftArrowKey()) stepBackward();
+		}
+
+		void StickCollectionController::togglePause()
+		{
+			if (sort_paused) resumeSort();
+			else
 			{
-				float x_position = (i * sticks[i]->stick_view->getSize().x + (i + 1) * collection_model->elements_spacing);
-				float y_position = collection_model->element_y_position - sticks[i]->stick_view->getSize().y;
+				undo_recording = true;
+				sort_paused = true;
+			}
+		}
 
-				sticks[i]->stick_view->setPosition(sf::Vector2f(x_position, y_position));
+		void StickCollectionController::resumeSort()
+		{
+			if (!sort_paused) return;
+
+			// The sort thread's own state matches the newest array, so undone operations are redone first.
+			if (isSortThreadWaiting()) while (undo_position < undo_count) stepForward();
+
+			std::unique_lock<std::mutex> lock(step_mutex);
+			sort_paused = false;
+			pending_steps = 0;
+			lock.unlock();
+			step_condition.notify_all();
+		}
 
+		bool StickCollectionController::isSortThreadWaiting()
+		{
+			std::lock_guard<std::mutex> lock(step_mutex);
+			return sort_thread_waiting && pending_steps == 0;
+		}
+
+		void StickCollectionController::stepForward()
+		{
+			if (!isSortThreadWaiting()) return;
+
+			if (undo_position == undo_count)
+			{
+				std::unique_lock<std::mutex> lock(step_mutex);
+				pending_steps++;
+				lock.unlock();
+				step_condition.notify_all();
+				return;
 			}
+
+			const UndoEntry& entry = getUndoEntry(undo_position++);
+			if (entry.type == OperationType::SWAP) std::swap(sticks[entry.first_index], sticks[entry.second_index]);
+			else sticks[entry.first_index] = entry.written_stick;
+
+			highlightUndoEntry(entry);
+		}
+
+		void StickCollectionController::stepBackward()
+		{
+			if (undo_position == 0 || !isSortThreadWaiting()) return;
+
+			const UndoEntry& entry = getUndoEntry(--undo_position);
+			if (entry.type == OperationType::SWAP) std::swap(sticks[entry.first_index], sticks[entry.second_index]);
+			else sticks[entry.first_index] = entry.previous_stick;
+
+			highlightUndoEntry(entry);
+		}
+
+		void StickCollectionController::highlightUndoEntry(const UndoEntry& entry)
+		{
+			resetSticksColor();
+			sticks[entry.first_index].color = collection_model->processing_element_color;
+			if (entry.type == OperationType::SWAP) sticks[entry.second_index].color = collection_model->processing_element_color;
 		}
 
-		float StickCollectionController::calculateStickHeight(int array_position)
+		void StickCollectionController::toggleOperationTrace()
 		{
+			collection_model->record_operation_trace = !collection_model->record_operation_trace;
+			printf("Operation trace recording %s\n", collection_model->record_operation_trace ? "enabled" : "disabled");
+		}
+
+		void StickCollectionController::beginOperationTrace()
+		{
+			if (!collection_model->record_operation_trace) return;
+
+			std::error_code error;
+			std::filesystem::create_directories(collection_model->operation_trace_directory, error);
 
-			return static_cast<float>(array_position + 1) / collection_model->number_of_elements * collection_model->max_element_height;
+			std::vector<int> initial_values(sticks.size());
+			for (int i = 0; i < sticks.size(); i++) initial_values[i] = sticks[i].data;
+
+			std::string file_path = std::string(collection_model->operation_trace_directory) + "/operation_trace_" + std::to_string(next_operation_trace_index++) + ".sstr";
+			if (operation_trace_writer->beginTrace(file_path, static_cast<int>(sort_type), initial_values)) last_operation_trace_path = file_path;
 		}
-		void StickCollectionController::shuffleSticks()
+
+		void StickCollectionController::runSortThread(void (StickCollectionController::*sort_function)())
 		{
-			std::random_device device;
-			std::mt19937 random_engine(device());
+			TRACE_THREAD_NAME("sort_thread");
+			if (collection_model->race_lane_index >= 0 && Threading::NumaMemory::isThreadPinningEnabled()) Threading::NumaMemory::pinCurrentThread(collection_model->race_lane_index);
+
+			(this->*sort_function)();
+			operation_trace_writer->endTrace();
 
-			std::shuffle(sticks.begin(), sticks.end(), random_engine);
-			updateStickPosition();
+			stability_check = checkStability();
+			sort_completed = true;
+			setCompletedColor();
+			sort_thread_finished = true;
+		}
+
+		void StickCollectionController::toggleReplay()
+		{
+			if (sort_state == SortState::REPLAYING) stopReplay();
+			else startReplay();
 		}
 
-		bool StickCollectionController::compareSticksByData(const Stick* a, const Stick* b) const
+		void StickCollectionController::startReplay()
 		{
-			return a->data < b->data;
+			if (sort_state == SortState::SORTING)
+			{
+				printf("Wait for the sort to finish before replaying it\n");
+				return;
+			}
+
+			if (last_operation_trace_path.empty())
+			{
+				printf("No operation trace recorded yet, enable recording with F7 and run a sort\n");
+				return;
+			}
+
+			if (!operation_trace_reader->open(last_operation_trace_path)) return;
+
+			if (operation_trace_reader->getValues().size() != sticks.size())
+			{
+				printf("Operation trace %s was recorded with a different number of sticks\n", last_operation_trace_path.c_str());
+				operation_trace_reader->close();
+				return;
+			}
+
+			sort_type = static_cast<SortType>(operation_trace_reader->getSortType());
+			sort_state = SortState::REPLAYING;
+			replay_position = 0;
+			replay_speed = 1000.f / collection_model->operation_delay;
+			replay_direction = 1;
+			replay_clock.restart();
+
+			printf("Replaying %s (%llu operations)\n", last_operation_trace_path.c_str(), static_cast<unsigned long long>(operation_trace_reader->getOperationCount()));
+			showReplayState();
+		}
+
+		void StickCollectionController::stopReplay()
+		{
+			operation_trace_reader->close();
+			sort_state = SortState::NOT_SORTING;
+			resetSticksColor();
+		}
+
+		void StickCollectionController::updateReplay()
+		{
+			Event::EventService* event_service = ServiceLocator::getInstance()->getEventService();
+
+			if (event_service->pressedRightArrowKey()) replay_direction = 1;
+			if (event_service->pressedLeftArrowKey()) replay_direction = -1;
+			if (event_service->pressedUpArrowKey()) replay_speed = std::min(replay_speed * 2.f, collection_model->max_replay_speed);
+			if (event_service->pressedDownArrowKey()) replay_speed = std::max(replay_speed * 0.5f, collection_model->min_replay_speed);
+
+			double operation_count = static_cast<double>(operation_trace_reader->getOperationCount());
+			replay_position += replay_direction * replay_speed * replay_clock.restart().asSeconds();
+			replay_position = std::max(0.0, std::min(replay_position, operation_count));
+
+			std::uint64_t operation_index = static_cast<std::uint64_t>(replay_position);
+			if (operation_index == operation_trace_reader->getPosition()) return;
+
+			operation_trace_reader->seek(operation_index);
+			showReplayState();
+		}
+
+		void StickCollectionController::showReplayState()
+		{
+			const std::vector<int>& values = operation_trace_reader->getValues();
+			for (int i = 0; i < sticks.size(); i++)
+			{
+				sticks[i].data = values[i];
+				sticks[i].color = collection_model->element_color;
+			}
+
+			if (operation_trace_reader->getPosition() > 0)
+			{
+				const TraceOperation& operation = operation_trace_reader->getLastOperation();
+				switch (operation.type)
+				{
+				case OperationType::COMPARE:
+					sticks[operation.first_index].color = collection_model->processing_element_color;
+					sticks[operation.second].color = collection_model->processing_element_color;
+					break;
+				case OperationType::SWAP:
+					sticks[operation.first_index].color = collection_model->temporary_elemrnt_color;
+					sticks[operation.second].color = collection_model->temporary_elemrnt_color;
+					break;
+				case OperationType::WRITE:
+					sticks[operation.first_index].color = collection_model->selected_element_color;
+					break;
+				}
+			}
+
+			if (operation_trace_reader->getPosition() == operation_trace_reader->getOperationCount())
+				for (int i = 0; i < sticks.size(); i++) sticks[i].color = collection_model->placement_position_element_color;
+
+			number_of_comparisons = static_cast<long long>(operation_trace_reader->getComparisons());
+			number_of_array_access = static_cast<long long>(operation_trace_reader->getArrayAccesses());
 		}
 
 		void StickCollectionController::processSortThreadState()
 		{
-			if (sort_thread.joinable() && isCollectionSorted())
+			if (sort_thread.joinable() && sort_thread_finished)
 			{
 				sort_thread.join();
 				sort_state = Collection::SortState::NOT_SORTING;
@@ -121,7 +607,7 @@ namespace Gameplay
 
 		void StickCollectionController::resetSticksColor()
 		{
-			for (int i = 0; i < sticks.size(); i++) sticks[i]->stick_view->setFillColor(collection_model->element_color);
+			for (int i = 0; i < sticks.size(); i++) sticks[i].color = collection_model->element_color;
 		}
 
 		void StickCollectionController::resetVariables()
@@ -135,9 +621,15 @@ namespace Gameplay
 			color_delay = 0;
 			sort_state = Collection::SortState::NOT_SORTING;
 			current_operation_delay = 0;
+			resumeSort();
 			if (sort_thread.joinable()) sort_thread.join();
+			operation_trace_reader->close();
+			clearUndoLog();
+			sort_completed = false;
+			stability_check = Sorting::StabilityCheck::NOT_CHECKED;
+			finish_place = 0;
 
-			shuffleSticks();
+			generateInputValues();
 			resetSticksColor();
 			resetVariables();
 		}
@@ -145,39 +637,56 @@ namespace Gameplay
 		void StickCollectionController::sortElements(SortType sort_type)
 		{
 			color_delay = collection_model->color_delay;
-			current_operation_delay = collection_model->operation_delay;
+			current_operation_delay = calculateOperationDelay();
 			this->sort_type = sort_type;
 			sort_state = Gameplay::Collection::SortState::SORTING;
+			sort_thread_finished = false;
+			sort_completed = false;
+			stability_check = Sorting::StabilityCheck::NOT_CHECKED;
+			finish_place = 0;
+			clearUndoLog();
+			time_complexity = getSortTypeInfo(sort_type).time_complexity;
+			beginOperationTrace();
 
 			switch (sort_type)
 			{
 			case Gameplay::Collection::SortType::BUBBLE_SORT:
-				collection_model->number_of_elements = 30;
-				sort_thread = std::thread(&StickCollectionController::processBubbleSort, this);
-				time_complexity = "O(n^2)";
+				sort_thread = std::thread(&StickCollectionController::runSortThread, this, &StickCollectionController::processBubbleSort);
 				break;
 			case Gameplay::Collection::SortType::INSERTION_SORT:
-				collection_model->number_of_elements = 30;
-				sort_thread = std::thread(&StickCollectionController::processInsertionSort, this);
-				time_complexity = "O(n^2)";
+				sort_thread = std::thread(&StickCollectionController::runSortThread, this, &StickCollectionController::processInsertionSort);
 				break;
 			case Gameplay::Collection::SortType::SELECTION_SORT:
-				collection_model->number_of_elements = 30;
-				sort_thread = std::thread(&StickCollectionController::processSelectionSort, this);
-				time_complexity = "O(n^2)";
+				sort_thread = std::thread(&StickCollectionController::runSortThread, this, &StickCollectionController::processSelectionSort);
 				break;
 			case Gameplay::Collection::SortType::MERGE_SORT:
-				collection_model->number_of_elements = 30 ;
-				sort_thread = std::thread(&StickCollectionController::processMergeSort, this);
-				time_complexity = "O(n Log n)";
+				sort_thread = std::thread(&StickCollectionController::runSortThread, this, &StickCollectionController::processMergeSort);
 				break;
 			case Gameplay::Collection::SortType::QUICK_SORT:
-				sort_thread = std::thread(&StickCollectionController::processQuickSort, this);
-				time_complexity = "O(n Log n)";
+				sort_thread = std::thread(&StickCollectionController::runSortThread, this, &StickCollectionController::processQuickSort);
 				break;
 			case Gameplay::Collection::SortType::RADIX_SORT:
-				sort_thread = std::thread(&StickCollectionController::processRadixSort, this);
-				time_complexity = "O(w*(n+k))";
+				sort_thread = std::thread(&StickCollectionController::runSortThread, this, &StickCollectionController::processRadixSort);
+				break;
+			case Gameplay::Collection::SortType::EXTERNAL_MERGE_SORT:
+				sort_thread = std::thread(&StickCollectionController::runSortThread, this, &StickCollectionController::processExternalMergeSort);
+				break;
+			case Gameplay::Collection::SortType::MULTIWAY_MERGE_SORT:
+				sort_thread = std::thread(&StickCollectionController::runSortThread, this, &StickCollectionController::processMultiwayMergeSort);
+				break;
+			case Gameplay::Collection::SortType::PARTIAL_SORT:
+				sort_thread = std::thread(&StickCollectionController::runSortThread, this, &StickCollectionController::processPartialSort);
+				break;
+			case Gameplay::Collection::SortType::NTH_ELEMENT:
+				sort_thread = std::thread(&StickCollectionController::runSortThread, this, &StickCollectionController::processNthElement);
+				break;
+			case Gameplay::Collection::SortType::TOP_K:
+				sort_thread = std::thread(&StickCollectionController::runSortThread, this, &StickCollectionController::processTopK);
+				break;
+			case Gameplay::Collection::SortType::AMERICAN_FLAG_SORT:
+				sort_thread = std::thread(&StickCollectionController::runSortThread, this, &StickCollectionController::processAmericanFlagSort);
+				break;
+			default:
 				break;
 			}
 			
@@ -187,40 +696,60 @@ namespace Gameplay
 
 		bool StickCollectionController::isCollectionSorted()
 		{
-			for (int i = 1; i < sticks.size(); i++) if (sticks[i] < sticks[i - 1]) return false;
+			for (int i = 1; i < sticks.size(); i++) if (compareSticksByData(sticks[i], sticks[i - 1])) return false;
 			return true;
 		}
 
 		void StickCollectionController::destroy()
 		{
 			current_operation_delay = 0;
+			resumeSort();
 			if (sort_thread.joinable()) sort_thread.join();
 
-			for (int i = 0; i < sticks.size(); i++) delete(sticks[i]);
 			sticks.clear();
 
 			delete (collection_view);
 			delete (collection_model);
+			delete (operation_trace_writer);
+			delete (operation_trace_reader);
 		}
 
 		SortType StickCollectionController::getSortType() { return sort_type; }
 
-		int StickCollectionController::getNumberOfComparisons() { return number_of_comparisons; }
+		long long StickCollectionController::getNumberOfComparisons() { return number_of_comparisons; }
 
-		int StickCollectionController::getNumberOfArrayAccess() { return number_of_array_access; }
+		long long StickCollectionController::getNumberOfArrayAccess() { return number_of_array_access; }
 
 		int StickCollectionController::getNumberOfSticks() { return collection_model->number_of_elements; }
 
+		InputDistribution StickCollectionController::getInputDistribution() { return collection_model->input_distribution; }
+
+		std::uint64_t StickCollectionController::getInputSeed() { return collection_model->input_seed; }
+
 		int StickCollectionController::getDelayMilliseconds() { return current_operation_delay; }
 
-		sf::String StickCollectionController::getTimeComplexity() { return time_complexity; }
+		const sf::String& StickCollectionController::getTimeComplexity() { return time_complexity; }
+
+		const std::string& StickCollectionController::getLastOperationTracePath() { return last_operation_trace_path; }
+
+		bool StickCollectionController::isSortCompleted() { return sort_completed; }
+
+		bool StickCollectionController::isStableSortMode() { return collection_model->stable_sort_mode; }
+
+		bool StickCollectionController::isStableSort() { return isStableSortType(sort_type, collection_model->stable_sort_mode); }
+
+		Sorting::StabilityCheck StickCollectionController::getStabilityCheck() { return stability_check; }
+
+		int StickCollectionController::getFinishPlace() { return finish_place; }
+
+		void StickCollectionController::setFinishPlace(int place) { finish_place = place; }
 
 		void StickCollectionController::setCompletedColor()
 		{
 			for (int i = 0; i < sticks.size(); i++)
 			{
 				if (sort_state == Collection::SortState::NOT_SORTING) break;
-				sticks[i]->stick_view->setFillColor(collection_model->element_color);
+				sticks[i].color = collection_model->element_color;
 
 			}
 			ServiceLocator::getInstance()->getSoundService()->playSound(Sound::SoundType::COMPARE_SFX);
@@ -228,9 +757,9 @@ namespace Gameplay
 			for (int i = 0; i < sticks.size(); i++)
 			{
 				if (sort_state == Collection::SortState::NOT_SORTING) break;
-				ServiceLocator::getInstance()->getSoundService()->playSound(Sound::SoundType::COMPARE_SFX);
-				std::this_thread::sleep_for(std::chrono::milliseconds(current_operation_delay));
-				sticks[i]->stick_view->setFillColor(collection_model->placement_position_element_color);
+				playCompareSound(i);
+				sleepForOperationDelay(current_operation_delay);
+				sticks[i].color = collection_model->placement_position_element_color;
 
 			}
 
@@ -238,6 +767,8 @@ namespace Gameplay
 
 		void StickCollectionController::processBubbleSort()
 		{
+			TRACE_SCOPE("processBubbleSort");
+
 			int length = sticks.size();
 			bool swapped;
 
@@ -249,117 +780,139 @@ namespace Gameplay
 					if (sort_state == Collection::SortState::NOT_SORTING) break;
 					number_of_array_access += 2;
 					number_of_comparisons++;
-					sticks[i]->stick_view->setFillColor(collection_model->processing_element_color);
-					sticks[i - 1]->stick_view->setFillColor(collection_model->processing_element_color);
-					ServiceLocator::getInstance()->getSoundService()->playSound(Sound::SoundType::COMPARE_SFX);
-					if (sticks[i - 1]->data > sticks[i]->data)
+					sticks[i].color = collection_model->processing_element_color;
+					sticks[i - 1].color = collection_model->processing_element_color;
+					playCompareSound(i);
+					recordComparison(i - 1, i);
+					if (compareSticksByData(sticks[i], sticks[i - 1]))
 					{
-						Stick* temp = sticks[i];
-						sticks[i] = sticks[i - 1];
-						sticks[i - 1] = temp;
+						swapSticks(i - 1, i);
 						swapped = true;
 					}
-					std::this_thread::sleep_for(std::chrono::milliseconds(current_operation_delay));
-					sticks[i]->stick_view->setFillColor(collection_model->element_color);
-					sticks[i - 1]->stick_view->setFillColor(collection_model->element_color);
-					updateStickPosition();
+					sleepForOperationDelay(current_operation_delay);
+					sticks[i].color = collection_model->element_color;
+					sticks[i - 1].color = collection_model->element_color;
 				}
-				sticks[length-1]->stick_view->setFillColor(collection_model->placement_position_element_color);
+				sticks[length-1].color = collection_model->placement_position_element_color;
 				
 				length--;
 			} while (swapped);
 
-			setCompletedColor();
 		}
 		void StickCollectionController::processInsertionSort()
 		{
-			for (int i = 1; i < sticks.size(); i++)
+			TRACE_SCOPE("processInsertionSort");
+
+			insertionSort(0, static_cast<int>(sticks.size()) - 1);
+		}
+
+		void StickCollectionController::insertionSort(int left, int right)
+		{
+			for (int i = left + 1; i <= right; i++)
 			{
 				int j = i - 1;
-				Stick* key = sticks[i];
+				Stick key = sticks[i];
 				number_of_array_access++;
-				key->stick_view->setFillColor(collection_model->processing_element_color);
-				std::this_thread::sleep_for(std::chrono::milliseconds(current_operation_delay));
+				key.color = collection_model->processing_element_color;
+				sleepForOperationDelay(current_operation_delay);
 
-				while (j >= 0 && sticks[j]->data > key->data)
+				while (j >= left)
 				{
 					if (sort_state == SortState::NOT_SORTING) break;
+
+					// The key logically sits in the gap at j + 1 while the larger sticks shift right.
+					recordComparison(j, j + 1);
+					if (!compareSticksByData(key, sticks[j])) break;
+
 					number_of_array_access++;
 					number_of_comparisons++;
-					sticks[j + 1] = sticks[j];
-					sticks[j + 1]->stick_view->setFillColor(collection_model->processing_element_color);
+					writeStick(j + 1, sticks[j]);
+					sticks[j + 1].color = collection_model->processing_element_color;
 					j--;
 
-					ServiceLocator::getInstance()->getSoundService()->playSound(Sound::SoundType::COMPARE_SFX);
-					updateStickPosition();
-					std::this_thread::sleep_for(std::chrono::milliseconds(current_operation_delay));
-					sticks[j + 2]->stick_view->setFillColor(collection_model->selected_element_color);
+					playCompareSound(j + 1);
+					sleepForOperationDelay(current_operation_delay);
+					sticks[j + 2].color = collection_model->selected_element_color;
 
 				}
 
-				sticks[j + 1] = key;
-				sticks[j+1]->stick_view->setFillColor(collection_model->temporary_elemrnt_color);
-				updateStickPosition();
-				std::this_thread::sleep_for(std::chrono::milliseconds(current_operation_delay));
-				sticks[j+1]->stick_view->setFillColor(collection_model->selected_element_color);
+				writeStick(j + 1, key);
+				sticks[j+1].color = collection_model->temporary_elemrnt_color;
+				sleepForOperationDelay(current_operation_delay);
+				sticks[j+1].color = collection_model->selected_element_color;
 
 			}
 
-			setCompletedColor();
 		}
 		void StickCollectionController::processSelectionSort()
 		{
+			TRACE_SCOPE("processSelectionSort");
+
 			for (int i = 0; i < sticks.size(); i++)
 			{
 				if (sort_state == SortState::NOT_SORTING) break;
 				int min_index = i;
-				sticks[i]->stick_view->setFillColor(collection_model->selected_element_color);
+				sticks[i].color = collection_model->selected_element_color;
 
 
 				for (int j = i + 0; j < sticks.size(); j++)
 				{
 					if (sort_state == SortState::NOT_SORTING) break;
 
-					ServiceLocator::getInstance()->getSoundService()->playSound(Sound::SoundType::COMPARE_SFX);
-					sticks[j]->stick_view->setFillColor(collection_model->processing_element_color);
+					playCompareSound(j);
+					sticks[j].color = collection_model->processing_element_color;
 					number_of_comparisons++;
 					number_of_array_access += 2;
-					std::this_thread::sleep_for(std::chrono::milliseconds(current_operation_delay));
+					sleepForOperationDelay(current_operation_delay);
 
-					if (sticks[min_index]->data > sticks[j]->data)
+					recordComparison(min_index, j);
+					if (compareSticksByData(sticks[j], sticks[min_index]))
 					{
-						sticks[min_index]->stick_view->setFillColor(collection_model->element_color);
+						sticks[min_index].color = collection_model->element_color;
 
 						min_index = j;
-						sticks[min_index]->stick_view->setFillColor(collection_model->temporary_elemrnt_color);
+						sticks[min_index].color = collection_model->temporary_elemrnt_color;
 					}
 					else
 					{
-						sticks[j]->stick_view->setFillColor(collection_model->element_color);
+						sticks[j].color = collection_model->element_color;
 
 					}
 				}
 
-				Stick* stick = sticks[min_index];
-				sticks[min_index] = sticks[i];
-				sticks[i] = stick;
-				number_of_array_access += 3;
-				sticks[i]->stick_view->setFillColor(collection_model->element_color);
-				updateStickPosition();
-				sticks[i]->stick_view->setFillColor(collection_model->placement_position_element_color);
+				if (collection_model->stable_sort_mode)
+				{
+					// Shifting the sticks in between right by one keeps equal keys in their input order.
+					Stick minimum = sticks[min_index];
+					for (int k = min_index; k > i; k--)
+					{
+						writeStick(k, sticks[k - 1]);
+						number_of_array_access += 2;
+					}
+					writeStick(i, minimum);
+					number_of_array_access += 2;
+				}
+				else
+				{
+					swapSticks(i, min_index);
+					number_of_array_access += 3;
+				}
+				sticks[i].color = collection_model->element_color;
+				sticks[i].color = collection_model->placement_position_element_color;
 
 			}
-			setCompletedColor();
 		}
 		void StickCollectionController::processInPlaceMergeSort()
 		{
+			TRACE_SCOPE("processInPlaceMergeSort");
+
 			inPlaceMergeSort(0, sticks.size() - 1);
-			setCompletedColor();
 		}
 		void StickCollectionController::inPlaceMerge(int left, int mid, int right)
 		{
 			int start2 = mid + 1;
-			if (sticks[mid]->data <= sticks[start2]->data)
+			recordComparison(mid, start2);
+			if (!compareSticksByData(sticks[start2], sticks[mid]))
 			{
 				number_of_comparisons++;
 				number_of_array_access += 2;
@@ -370,37 +923,39 @@ namespace Gameplay
 			{
 				number_of_comparisons++;
 				number_of_array_access += 2;
-				if (sticks[left]->data < sticks[start2]->data)
+				recordComparison(left, start2);
+				if (compareSticksByData(sticks[left], sticks[start2]))
 				{
 					left++;
 				}
 				else
 				{
-					Stick* value = sticks[start2];
+					Stick value = sticks[start2];
 					for (int k = start2; k > left; k--)
 					{
-						sticks[k] = sticks[k - 1];
+						writeStick(k, sticks[k - 1]);
 						number_of_array_access += 2;
 					}
 
-					sticks[left] = value;
+					writeStick(left, value);
 					number_of_array_access += 2;
 					left++;
 					start2++;
 					mid++;
-					updateStickPosition();
 
 				}
-				ServiceLocator::getInstance()->getSoundService()->playSound(Sound::SoundType::COMPARE_SFX);
-				sticks[left - 1]->stick_view->setFillColor(collection_model->processing_element_color);
-				std::this_thread::sleep_for(std::chrono::milliseconds(current_operation_delay));
-				sticks[left - 1]->stick_view->setFillColor(collection_model->element_color);
+				playCompareSound(left - 1);
+				sticks[left - 1].color = collection_model->processing_element_color;
+				sleepForOperationDelay(current_operation_delay);
+				sticks[left - 1].color = collection_model->element_color;
 			}
 
 
 		}
 		void StickCollectionController::inPlaceMergeSort(int left, int right)
 		{
+			TRACE_SCOPE("inPlaceMergeSort");
+
 			if (left < right)
 			{
 				int mid = left + (right - left) / 2;
@@ -411,13 +966,74 @@ namespace Gameplay
 		}
 		void StickCollectionController::processMergeSort()
 		{
+			TRACE_SCOPE("processMergeSort");
+
 			mergeSort(0, sticks.size() - 1);
-			setCompletedColor();
 		}
+		// Bottom-up merge sort that merges multiway_merge_ways runs per pass instead of two, so it needs
+		// log_k(n) passes over the sticks instead of log2(n).
+		void StickCollectionController::processMultiwayMergeSort()
+		{
+			TRACE_SCOPE("processMultiwayMergeSort");
+
+			int number_of_sticks = static_cast<int>(sticks.size());
+			int ways = collection_model->multiway_merge_ways;
+
+			for (long long run_length = 1; run_length < number_of_sticks; run_length *= ways)
+			{
+				TRACE_SCOPE("multiwayMergePass");
+				for (long long left = 0; left < number_of_sticks; left += run_length * ways)
+					multiwayMerge(static_cast<int>(left), static_cast<int>(run_length), static_cast<int>(std::min<long long>(number_of_sticks, left + run_length * ways)));
+			}
+		}
+
+		// Merges the runs of run_length sticks in [left, right) through a loser tree whose keys are
+		// positions in a copy of the range, so every match is a recorded comparison of two sticks.
+		void StickCollectionController::multiwayMerge(int left, int run_length, int right)
+		{
+			if (right - left <= run_length) return; // a lone trailing run is already in place
+
+			std::vector<Stick> temp(sticks.begin() + left, sticks.begin() + right);
+			for (int index = left; index < right; index++)
+			{
+				number_of_array_access++;
+				sticks[index].color = collection_model->temporary_elemrnt_color;
+			}
+
+			int run_count = (right - left + run_length - 1) / run_length;
+			auto smaller_stick = [&](int a, int b)
+				{
+					recordComparison(left + a, left + b);
+					number_of_comparisons++;
+					return compareSticksByData(temp[a], temp[b]);
+				};
+
+			Sorting::LoserTree<int, decltype(smaller_stick)> run_tree(run_count, smaller_stick);
+			for (int run = 0; run < run_count; run++) run_tree.setSource(run, run * run_length);
+			run_tree.build();
+
+			for (int k = left; !run_tree.empty(); k++)
+			{
+				int position = run_tree.winnerKey();
+				int run_end = std::min(right - left, (position / run_length + 1) * run_length);
+
+				number_of_array_access++;
+				writeStick(k, temp[position]);
+				if (position + 1 < run_end) run_tree.replaceWinner(position + 1);
+				else run_tree.removeWinner();
+
+				playCompareSound(k);
+				sticks[k].color = collection_model->processing_element_color;
+				sleepForOperationDelay(current_operation_delay);
+			}
+
+			for (int index = left; index < right; index++) sticks[index].color = collection_model->element_color;
+		}
+
 		void StickCollectionController::merge(int left, int mid, int right)
 		{
 			int n = right - left + 1;
-			std::vector<Stick*> temp(n);
+			std::vector<Stick> temp(n);
 		
 			int k = 0;
 
@@ -425,8 +1041,7 @@ namespace Gameplay
 			{
 				temp[k++] = sticks[index];
 				number_of_array_access++;
-				sticks[index]->stick_view->setFillColor(collection_model->temporary_elemrnt_color);
-				updateStickPosition();
+				sticks[index].color = collection_model->temporary_elemrnt_color;
 			}
 
 			int i = 0;
@@ -436,23 +1051,23 @@ namespace Gameplay
 
 			while (i <mid - left+1 && j < n)
 			{
-				if (temp[i]->data <= temp[j]->data)
+				recordComparison(left + i, left + j);
+				if (!compareSticksByOrder(temp[j], temp[i]))
 				{
 					number_of_array_access++;
-					sticks[k] = temp[i];
+					writeStick(k, temp[i]);
 					i++;
 				}
 				else
 				{
 					number_of_array_access++;
-					sticks[k] = temp[j];
+					writeStick(k, temp[j]);
 					j++;
 				}
 
-				ServiceLocator::getInstance()->getSoundService()->playSound(Sound::SoundType::COMPARE_SFX);
-				sticks[k]->stick_view->setFillColor(collection_model->processing_element_color);
-				updateStickPosition();
-				std::this_thread::sleep_for(std::chrono::milliseconds(current_operation_delay));
+				playCompareSound(k);
+				sticks[k].color = collection_model->processing_element_color;
+				sleepForOperationDelay(current_operation_delay);
 				k++;
 			}
 
@@ -462,23 +1077,24 @@ namespace Gameplay
 
 				if (i < mid-left+1)
 				{
-					sticks[k] = temp[i];
+					writeStick(k, temp[i]);
 					i++;
 				}
 				else
 				{
-					sticks[k] = temp[j];
+					writeStick(k, temp[j]);
 					j++;
 				}
-				ServiceLocator::getInstance()->getSoundService()->playSound(Sound::SoundType::COMPARE_SFX);
-				sticks[k]->stick_view->setFillColor(collection_model->processing_element_color);
-				updateStickPosition();
-				std::this_thread::sleep_for(std::chrono::milliseconds(current_operation_delay));
+				playCompareSound(k);
+				sticks[k].color = collection_model->processing_element_color;
+				sleepForOperationDelay(current_operation_delay);
 				k++;
 			}
 		}
 		void StickCollectionController::mergeSort(int left, int right)
 		{
+			TRACE_SCOPE("mergeSort");
+
 			if (left < right)
 			{
 				int mid = left + (right - left) / 2;
@@ -489,72 +1105,234 @@ namespace Gameplay
 		}
 		void StickCollectionController::processQuickSort()
 		{
+			TRACE_SCOPE("processQuickSort");
+
 			quickSort(0, sticks.size() - 1);
-			setCompletedColor();
 		}
 		int StickCollectionController::partition(int low, int high)
 		{
-			int pivot = sticks[high]->data;
-			sticks[high]->stick_view->setFillColor(collection_model->selected_element_color);
+			Stick pivot = sticks[high];
+			sticks[high].color = collection_model->selected_element_color;
 			int i = low - 1;
 			for (int j = low; j <= high - 1; j++)
 			{
-				sticks[j]->stick_view->setFillColor(collection_model->processing_element_color);
+				sticks[j].color = collection_model->processing_element_color;
 				number_of_array_access++;
 				number_of_comparisons++;
-				if (sticks[j]->data <= pivot)
+				recordComparison(j, high);
+				if (!compareSticksByOrder(pivot, sticks[j]))
 				{
 					i++;
-					std::swap(sticks[i], sticks[j]);
-					ServiceLocator::getInstance()->getSoundService()->playSound(Sound::SoundType::COMPARE_SFX);
-					updateStickPosition();
-					std::this_thread::sleep_for(std::chrono::milliseconds(current_operation_delay));
+					swapSticks(i, j);
+					playCompareSound(i);
+					sleepForOperationDelay(current_operation_delay);
 					number_of_array_access++;
 
 				}
 				else
 				{
-					sticks[j]->stick_view->setFillColor(collection_model->element_color);
+					sticks[j].color = collection_model->element_color;
 				}
 			}
 
-			std::swap(sticks[i + 1], sticks[high]);
-			updateStickPosition();
+			swapSticks(i + 1, high);
 			number_of_array_access += 2;
 			return i + 1;
 
 		}
 		void StickCollectionController::quickSort(int low, int high)
 		{
-			if (low < high)
+			TRACE_SCOPE("quickSort");
+
+			// Recursing into the smaller side only keeps the stack depth logarithmic for large collections.
+			while (low < high)
 			{
 				int pivot_index = partition(low, high);
-				quickSort(low, pivot_index - 1);
-				quickSort(pivot_index + 1, high);
+				if (pivot_index - low < high - pivot_index)
+				{
+					quickSort(low, pivot_index - 1);
+					low = pivot_index + 1;
+				}
+				else
+				{
+					quickSort(pivot_index + 1, high);
+					high = pivot_index - 1;
+				}
 			}
-	
+		}
+		// Only the smallest k sticks end up sorted: selecting them first is linear, then just those k are quick sorted.
+		void StickCollectionController::processPartialSort()
+		{
+			TRACE_SCOPE("processPartialSort");
 
+			int selection_count = getSelectionCount();
+			if (selection_count < sticks.size()) quickSelect(0, static_cast<int>(sticks.size()) - 1, selection_count - 1);
+			for (int i = selection_count; i < sticks.size(); i++) sticks[i].color = collection_model->element_color;
+
+			quickSort(0, selection_count - 1);
 		}
+
+		void StickCollectionController::processNthElement()
+		{
+			TRACE_SCOPE("processNthElement");
+
+			int nth = static_cast<int>(sticks.size()) / 2;
+			quickSelect(0, static_cast<int>(sticks.size()) - 1, nth);
+			sticks[nth].color = collection_model->placement_position_element_color;
+		}
+
+		// Introselect on the existing partition(): quickselect with a median of three pivot, which falls
+		// back to merge sorting the remaining range once it has partitioned 2 log2(n) times without
+		// reaching nth, so adversarial inputs stay O(n log n).
+		void StickCollectionController::quickSelect(int low, int high, int nth)
+		{
+			TRACE_SCOPE("quickSelect");
+
+			int depth_limit = 2;
+			for (int length = high - low + 1; length > 1; length >>= 1) depth_limit += 2;
+
+			while (low < high)
+			{
+				if (sort_state == SortState::NOT_SORTING) return;
+				if (depth_limit-- == 0)
+				{
+					mergeSort(low, high);
+					return;
+				}
+
+				moveMedianOfThreeToEnd(low, high);
+				int pivot_index = partition(low, high);
+
+				for (int i = low; i <= high; i++) sticks[i].color = collection_model->element_color;
+				if (pivot_index == nth) return;
+				if (nth < pivot_index) high = pivot_index - 1;
+				else low = pivot_index + 1;
+			}
+		}
+
+		// Orders sticks[low], the middle stick and sticks[high] so the median of the three is partition()'s pivot.
+		void StickCollectionController::moveMedianOfThreeToEnd(int low, int high)
+		{
+			if (high - low < 2) return;
+			int mid = low + (high - low) / 2;
+
+			number_of_comparisons += 3;
+			number_of_array_access += 6;
+
+			recordComparison(mid, low);
+			if (compareSticksByOrder(sticks[mid], sticks[low])) swapSticks(mid, low);
+			recordComparison(high, low);
+			if (compareSticksByOrder(sticks[high], sticks[low])) swapSticks(high, low);
+			recordComparison(mid, high);
+			if (compareSticksByOrder(sticks[mid], sticks[high])) swapSticks(mid, high);
+		}
+
+		// The k largest sticks are gathered in a min-heap laid out backward from the last stick, so each
+		// remaining stick costs one comparison against the heap's smallest unless it beats it. Popping
+		// the heap afterward leaves them sorted at the end of the array.
+		void StickCollectionController::processTopK()
+		{
+			TRACE_SCOPE("processTopK");
+
+			int number_of_sticks = static_cast<int>(sticks.size());
+			int selection_count = getSelectionCount();
+
+			for (int root = selection_count / 2 - 1; root >= 0; root--) siftDownTopK(root, selection_count);
+
+			int heap_top = number_of_sticks - 1;
+			for (int i = number_of_sticks - selection_count - 1; i >= 0; i--)
+			{
+				if (sort_state == SortState::NOT_SORTING) return;
+
+				playCompareSound(i);
+				sticks[i].color = collection_model->processing_element_color;
+				number_of_comparisons++;
+				number_of_array_access += 2;
+				recordComparison(heap_top, i);
+
+				if (compareSticksByOrder(sticks[heap_top], sticks[i]))
+				{
+					swapSticks(i, heap_top);
+					number_of_array_access += 2;
+					siftDownTopK(0, selection_count);
+				}
+				sleepForOperationDelay(current_operation_delay);
+				sticks[i].color = collection_model->element_color;
+			}
+
+			for (int heap_size = selection_count; heap_size > 1; heap_size--)
+			{
+				if (sort_state == SortState::NOT_SORTING) return;
+
+				swapSticks(heap_top, number_of_sticks - heap_size);
+				number_of_array_access += 2;
+				sticks[number_of_sticks - heap_size].color = collection_model->placement_position_element_color;
+				siftDownTopK(0, heap_size - 1);
+			}
+		}
+
+		// Heap slot h lives at sticks[size - 1 - h]; each slot is no greater than its children.
+		void StickCollectionController::siftDownTopK(int root, int heap_size)
+		{
+			int last_stick = static_cast<int>(sticks.size()) - 1;
+
+			for (int child = 2 * root + 1; child < heap_size; child = 2 * root + 1)
+			{
+				if (child + 1 < heap_size)
+				{
+					number_of_comparisons++;
+					number_of_array_access += 2;
+					recordComparison(last_stick - child - 1, last_stick - child);
+					if (compareSticksByOrder(sticks[last_stick - child - 1], sticks[last_stick - child])) child++;
+				}
+
+				number_of_comparisons++;
+				number_of_array_access += 2;
+				recordComparison(last_stick - child, last_stick - root);
+				if (!compareSticksByOrder(sticks[last_stick - child], sticks[last_stick - root])) return;
+
+				swapSticks(last_stick - child, last_stick - root);
+				number_of_array_access += 2;
+				playCompareSound(last_stick - root);
+				sticks[last_stick - root].color = collection_model->temporary_elemrnt_color;
+				sleepForOperationDelay(current_operation_delay);
+				sticks[last_stick - root].color = collection_model->element_color;
+				root = child;
+			}
+		}
+
 		void StickCollectionController::processRadixSort()
 		{
+			TRACE_SCOPE("processRadixSort");
+
 			radixSort();
-			setCompletedColor();
 		}
-		void StickCollectionController::countSort(int exponent)
+		// Digits are taken from the order-preserving radix key minus that of the smallest key, so negative
+		// and full range 32 bit keys work.
+		int StickCollectionController::getRadixDigit(const Stick& stick, int min_value, std::uint64_t exponent) const
 		{
+			using Traits = Sorting::KeyTraits<Stick::Key>;
+			Traits::RadixKey key = Traits::toRadixKey(stick.data) - Traits::toRadixKey(min_value);
+			return static_cast<int>((key / exponent) % 10);
+		}
+
+		void StickCollectionController::countSort(int min_value, std::uint64_t exponent)
+		{
+			TRACE_SCOPE("countSort");
+
 			int size = 10;
-			std::vector<Stick*> output_sticks(sticks.size());
+			std::vector<Stick> output_sticks(sticks.size());
 			std::vector<int> count(10, 0);
 
 			for (int i = 0; i < sticks.size(); i++)
 			{
-				ServiceLocator::getInstance()->getSoundService()->playSound(Sound::SoundType::COMPARE_SFX);
-				int digit = (sticks[i]->data / exponent) % 10;
+				playCompareSound(i);
+				int digit = getRadixDigit(sticks[i], min_value, exponent);
 				count[digit]++;
 				number_of_array_access++;
-				sticks[i]->stick_view->setFillColor(collection_model->processing_element_color);
-				std::this_thread::sleep_for(std::chrono::milliseconds(current_operation_delay / 2));
-				sticks[i]->stick_view->setFillColor(collection_model->element_color);
+				sticks[i].color = collection_model->processing_element_color;
+				sleepForOperationDelay(current_operation_delay / 2);
+				sticks[i].color = collection_model->element_color;
 			}
 
 			for (int i = 1; i < 10; i++)
@@ -564,10 +1342,10 @@ namespace Gameplay
 
 			for (int i = sticks.size() - 1; i >= 0; i--)
 			{
-				int digit = (sticks[i]->data / exponent) % 10;
+				int digit = getRadixDigit(sticks[i], min_value, exponent);
 				int index = count[digit] - 1;
 				output_sticks[index] = sticks[i];
-				sticks[i]->stick_view->setFillColor(collection_model->temporary_elemrnt_color);
+				sticks[i].color = collection_model->temporary_elemrnt_color;
 				count[digit]--;
 				number_of_array_access++;
 
@@ -575,36 +1353,202 @@ namespace Gameplay
 
 			for (int i = 0; i < output_sticks.size(); i++)
 			{
-				sticks[i] = output_sticks[i];
-				sticks[i]->stick_view->setFillColor(collection_model->selected_element_color);
-				updateStickPosition(i);
-				std::this_thread::sleep_for(std::chrono::milliseconds(current_operation_delay));
+				writeStick(i, output_sticks[i]);
+				sticks[i].color = collection_model->selected_element_color;
+				sleepForOperationDelay(current_operation_delay);
 			}
 
 		}
-		void StickCollectionController::updateStickPosition(int i)
+		// In-place MSD radix sort on decimal digits, unlike countSort() which scatters into a second
+		// array. Every stick is swapped straight into the next free slot of its digit's bucket, then
+		// buckets above american_flag_insertion_threshold go on to the next digit and smaller ones
+		// are insertion sorted.
+		void StickCollectionController::processAmericanFlagSort()
 		{
-			float x_position = (i * sticks[i]->stick_view->getSize().x) + ((i)*collection_model->elements_spacing);
-			float y_position = collection_model->element_y_position - sticks[i]->stick_view->getSize().y;
+			TRACE_SCOPE("processAmericanFlagSort");
+
+			int min_value = collection_model->min_value;
+			std::uint32_t max_key = static_cast<std::uint32_t>(collection_model->max_value) - static_cast<std::uint32_t>(min_value);
+
+			std::uint64_t exponent = 1;
+			while (max_key / exponent >= 10) exponent *= 10;
 
-			sticks[i]->stick_view->setPosition(sf::Vector2f(x_position, y_position));
+			americanFlagSort(0, static_cast<int>(sticks.size()), min_value, exponent);
 		}
+
+		void StickCollectionController::americanFlagSort(int left, int right, int min_value, std::uint64_t exponent)
+		{
+			TRACE_SCOPE("americanFlagSort");
+
+			int counts[10] = {};
+			for (int i = left; i < right; i++)
+			{
+				if (sort_state == SortState::NOT_SORTING) return;
+
+				playCompareSound(i);
+				counts[getRadixDigit(sticks[i], min_value, exponent)]++;
+				number_of_array_access++;
+				sticks[i].color = collection_model->processing_element_color;
+				sleepForOperationDelay(current_operation_delay / 2);
+				sticks[i].color = collection_model->element_color;
+			}
+
+			int heads[10];
+			int tails[10];
+			for (int digit = 0, offset = left; digit < 10; digit++)
+			{
+				heads[digit] = offset;
+				offset += counts[digit];
+				tails[digit] = offset;
+			}
+
+			for (int digit = 0; digit < 10; digit++)
+			{
+				while (heads[digit] < tails[digit])
+				{
+					if (sort_state == SortState::NOT_SORTING) return;
+
+					int position = heads[digit];
+					int stick_digit = getRadixDigit(sticks[position], min_value, exponent);
+					number_of_array_access++;
+
+					if (stick_digit == digit)
+					{
+						sticks[position].color = collection_model->placement_position_element_color;
+						heads[digit]++;
+						continue;
+					}
+
+					swapSticks(position, heads[stick_digit]);
+					number_of_array_access += 2;
+					playCompareSound(heads[stick_digit]);
+					sticks[heads[stick_digit]].color = collection_model->placement_position_element_color;
+					heads[stick_digit]++;
+					sleepForOperationDelay(current_operation_delay);
+				}
+			}
+
+			if (exponent == 1) return;
+
+			for (int digit = 0, first = left; digit < 10; first += counts[digit], digit++)
+			{
+				if (counts[digit] > collection_model->american_flag_insertion_threshold) americanFlagSort(first, first + counts[digit], min_value, exponent / 10);
+				else if (counts[digit] > 1) insertionSort(first, first + counts[digit] - 1);
+			}
+		}
+
 		void StickCollectionController::radixSort()
 		{
-			int max = sticks[0]->data;
+			int min = sticks[0].data;
+			int max = sticks[0].data;
 
 			for (int i = 1; i < sticks.size(); i++)
 			{
-				if (sticks[i]->data > max)
+				if (sticks[i].data > max)
+				{
+					max = sticks[i].data;
+				}
+				if (sticks[i].data < min)
+				{
+					min = sticks[i].data;
+				}
+			}
+
+			std::uint32_t max_key = static_cast<std::uint32_t>(max) - static_cast<std::uint32_t>(min);
+			for (std::uint64_t exponent = 1; max_key / exponent > 0; exponent *= 10)
+			{
+				countSort(min, exponent);
+			}
+		}
+
+		// Sorts the collection run by run as if only one run fit in memory: each sorted run is spilled to a
+		// temporary file in the background while the next one is sorted, then all runs are merged back.
+		void StickCollectionController::processExternalMergeSort()
+		{
+			TRACE_SCOPE("processExternalMergeSort");
+
+			int number_of_sticks = static_cast<int>(sticks.size());
+			int run_length = std::max(collection_model->min_external_run_length, (number_of_sticks + collection_model->external_run_count - 1) / collection_model->external_run_count);
+
+			std::error_code error;
+			std::filesystem::create_directories(collection_model->external_run_directory, error);
+			std::string run_prefix = std::string(collection_model->external_run_directory) + "/run_" + std::to_string(next_external_sort_index++) + "_";
+
+			std::vector<std::string> run_paths;
+			std::vector<int> run_begins;
+			std::vector<int> original_indices(number_of_sticks); // only the keys go to disk
+			std::future<bool> pending_spill;
+			bool spilled = true;
+
+			for (int begin = 0; begin < number_of_sticks && spilled; begin += run_length)
+			{
+				int end = std::min(number_of_sticks, begin + run_length);
+				quickSort(begin, end - 1);
+
+				std::vector<int> run_values(end - begin);
+				for (int i = begin; i < end; i++)
 				{
-					max = sticks[i]->data;
+					run_values[i - begin] = sticks[i].data;
+					original_indices[i] = sticks[i].original_index;
+					number_of_array_access++;
+					sticks[i].color = collection_model->placement_position_element_color;
 				}
+
+				if (pending_spill.valid()) spilled = pending_spill.get();
+				run_paths.push_back(run_prefix + std::to_string(run_paths.size()) + ".bin");
+				run_begins.push_back(begin);
+				pending_spill = ExternalRunFile::writeRunAsync(run_paths.back(), std::move(run_values));
 			}
 
+			if (pending_spill.valid()) spilled = pending_spill.get() && spilled;
+			if (spilled) mergeExternalRuns(run_paths, run_begins, original_indices);
+			else printf("Cannot write run files to %s\n", collection_model->external_run_directory);
 
-			for (int exponent = 1; max / exponent > 0; exponent *= 10)
+			for (const std::string& run_path : run_paths) std::filesystem::remove(run_path, error);
+		}
+
+		// Run heads are compared at the positions they were sorted at, so the view shows which runs compete;
+		// the values themselves come from the run files since the merge overwrites those positions.
+		void StickCollectionController::mergeExternalRuns(const std::vector<std::string>& run_paths, const std::vector<int>& run_begins, const std::vector<int>& original_indices)
+		{
+			TRACE_SCOPE("mergeExternalRuns");
+
+			std::vector<ExternalRunReader> readers(run_paths.size());
+			std::vector<int> consumed(run_paths.size(), 0);
+
+			for (std::size_t i = 0; i < run_paths.size(); i++)
+			{
+				if (readers[i].open(run_paths[i], collection_model->external_read_block_values)) continue;
+
+				printf("Cannot open run %s\n", run_paths[i].c_str());
+				return;
+			}
+
+			// The tree's keys are run numbers; a match compares the current heads of both runs.
+			auto smaller_head = [&](std::size_t a, std::size_t b)
+				{
+					recordComparison(run_begins[a] + consumed[a], run_begins[b] + consumed[b]);
+					number_of_comparisons++;
+					return Sorting::KeyTraits<Stick::Key>::less(readers[a].peekValue(), readers[b].peekValue());
+				};
+			Sorting::LoserTree<std::size_t, decltype(smaller_head)> run_tree(readers.size(), smaller_head);
+			for (std::size_t i = 0; i < readers.size(); i++) if (readers[i].hasValue()) run_tree.setSource(i, i);
+			run_tree.build();
+
+			for (int k = 0; !run_tree.empty(); k++)
 			{
-				countSort(exponent);
+				std::size_t run = run_tree.winner();
+
+				writeStick(k, Stick(readers[run].peekValue(), collection_model->processing_element_color, original_indices[run_begins[run] + consumed[run]]));
+				number_of_array_access++;
+				consumed[run]++;
+				readers[run].advance();
+				if (readers[run].hasValue()) run_tree.replaceWinner(run);
+				else run_tree.removeWinner();
+
+				playCompareSound(k);
+				sleepForOperationDelay(current_operation_delay);
+				sticks[k].color = collection_model->selected_element_color;
 			}
 		}
 	}
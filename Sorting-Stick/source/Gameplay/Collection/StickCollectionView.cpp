@@ -1,28 +1,127 @@
 #include "Gameplay/Collection/StickCollectionView.h"
+#include "Gameplay/Collection/StickCollectionController.h"
+#include "Gameplay/Collection/StickCollectionModel.h"
+#include "Global/ServiceLocator.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
 
 namespace Gameplay {
 	namespace Collection {
 
+		using namespace UI::UIElement;
+		using namespace Global;
+
 		StickCollectionView::StickCollectionView()
 		{
+			stick_vertices.setPrimitiveType(sf::Triangles);
+			lane_label = new TextView();
+			has_lane_label = false;
 		}
 
 		StickCollectionView::~StickCollectionView()
 		{
+			delete (lane_label);
 		}
 
-		void StickCollectionView::initialize(StickCollectionController* collection_controller)
+		void StickCollectionView::initialize(StickCollectionController* collection_controller, StickCollectionModel* collection_model)
 		{
 			this->collection_controller = collection_controller;
+			this->collection_model = collection_model;
 		}
 
 		void StickCollectionView::update()
 		{
+			if (!has_lane_label || lane_label_clock.getElapsedTime().asSeconds() < 1.f / lane_label_refresh_rate) return;
+
+			lane_label_clock.restart();
+			updateLaneLabel();
 		}
 
 		void StickCollectionView::render()
 		{
+			if (has_lane_label) lane_label->render();
+		}
+
+		void StickCollectionView::renderSticks(const std::vector<Stick>& sticks)
+		{
+			updateStickVertices(sticks);
+
+			ServiceLocator::getInstance()->getGraphicService()->getGameWindow()->draw(stick_vertices);
+			ServiceLocator::getInstance()->getProfilingService()->recordDrawCall();
+		}
+
+		void StickCollectionView::appendStickVerticesToBatch(sf::VertexArray& stick_batch)
+		{
+			for (std::size_t i = 0; i < stick_vertices.getVertexCount(); i++) stick_batch.append(stick_vertices[i]);
+		}
+
+		// Lays the sticks out inside the lane bounds. When there are more sticks than pixel columns each
+		// column shows one sampled stick, so the cost per frame depends on the lane width, not on the stick count.
+		void StickCollectionView::updateStickVertices(const std::vector<Stick>& sticks)
+		{
+			if (sticks.empty()) return;
+
+			sf::RenderWindow* game_window = ServiceLocator::getInstance()->getGraphicService()->getGameWindow();
+			sf::Vector2f reference_resolution = ServiceLocator::getInstance()->getGraphicService()->getReferenceResolution();
+			sf::Vector2f scale(game_window->getSize().x / reference_resolution.x, game_window->getSize().y / reference_resolution.y);
+
+			const sf::FloatRect& lane = collection_model->lane_bounds;
+			std::size_t stick_count = sticks.size();
+			std::size_t max_columns = static_cast<std::size_t>(std::max(1.f, lane.width * scale.x / collection_model->min_column_pixel_width));
+			std::size_t column_count = std::min(stick_count, max_columns);
+
+			float column_width = lane.width / column_count;
+			float spacing = 0.f;
+			if (column_count == stick_count && column_width * scale.x >= collection_model->min_spaced_column_pixel_width) spacing = column_width * collection_model->space_percentage;
+			collection_model->setElementSpacing(spacing);
+
+			float bottom = (lane.top + lane.height) * scale.y;
+			long long min_value = collection_model->min_value;
+			float height_per_value = static_cast<float>(lane.height * scale.y / (static_cast<double>(collection_model->max_value) - min_value + 1.0));
+
+			if (stick_vertices.getVertexCount() != column_count * 6) stick_vertices.resize(column_count * 6);
+
+			for (std::size_t column = 0; column < column_count; column++)
+			{
+				std::size_t index = column_count == stick_count ? column : static_cast<std::size_t>(static_cast<std::uint64_t>(column) * stick_count / column_count);
+				const Stick& stick = sticks[index];
+
+				float left = (lane.left + column * column_width + spacing * 0.5f) * scale.x;
+				float right = left + (column_width - spacing) * scale.x;
+				float top = bottom - std::min(lane.height * scale.y, (stick.data - min_value + 1) * height_per_value);
+
+				sf::Vertex* quad = &stick_vertices[column * 6];
+				quad[0] = sf::Vertex(sf::Vector2f(left, top), stick.color);
+				quad[1] = sf::Vertex(sf::Vector2f(right, top), stick.color);
+				quad[2] = sf::Vertex(sf::Vector2f(right, bottom), stick.color);
+				quad[3] = sf::Vertex(sf::Vector2f(left, top), stick.color);
+				quad[4] = sf::Vertex(sf::Vector2f(right, bottom), stick.color);
+				quad[5] = sf::Vertex(sf::Vector2f(left, bottom), stick.color);
+			}
+		}
+
+		void StickCollectionView::setLaneLabelPosition(sf::Vector2f position)
+		{
+			lane_label->initialize("", position, FontType::DS_DIGIB, lane_label_font_size);
+
+			has_lane_label = true;
+			updateLaneLabel();
+		}
+
+		void StickCollectionView::updateLaneLabel()
+		{
+			char label[160];
+			int finish_place = collection_controller->getFinishPlace();
+
+			if (finish_place > 0)
+				snprintf(label, sizeof(label), "#%d  %s   Comparisons : %lld   Array Access : %lld   %s", finish_place, getSortTypeName(collection_controller->getSortType()), collection_controller->getNumberOfComparisons(), collection_controller->getNumberOfArrayAccess(), Sorting::getStabilityCheckName(collection_controller->getStabilityCheck()));
+			else
+				snprintf(label, sizeof(label), "%s   Comparisons : %lld   Array Access : %lld", getSortTypeName(collection_controller->getSortType()), collection_controller->getNumberOfComparisons(), collection_controller->getNumberOfArrayAccess());
+
+			lane_label->setText(label);
+			lane_label->update();
 		}
 
 	}
-}
\ No newline at end of file
+}
@@ -1,6 +1,12 @@
 #include "Gameplay/GameplayService.h"
 #include "Gameplay/GameplayController.h"
 #include "Global/ServiceLocator.h"
+#include "Global/CommandLineOptions.h"
+#include "Gameplay/Collection/InputGenerator.h"
+#include "Threading/TaskScheduler.h"
+#include <algorithm>
+#include <cstdio>
+#include <string>
 
 namespace Gameplay
 {
@@ -10,10 +16,15 @@ namespace Gameplay
 	{
 		gameplay_controller = new GameplayController();
 		collection_controller = new StickCollectionController();
+		race_mode = false;
+		race_sort_types = { SortType::BUBBLE_SORT, SortType::INSERTION_SORT, SortType::SELECTION_SORT, SortType::MERGE_SORT,
+			SortType::QUICK_SORT, SortType::RADIX_SORT, SortType::EXTERNAL_MERGE_SORT, SortType::MULTIWAY_MERGE_SORT };
+		race_stick_batch.setPrimitiveType(sf::Triangles);
 	}
 
 	GameplayService::~GameplayService()
 	{
+		destroyRace();
 		delete (gameplay_controller);
 		delete (collection_controller);
 	}
@@ -22,27 +33,169 @@ namespace Gameplay
 	{
 		std::srand(static_cast<unsigned int>(std::time(nullptr))); //set seed
 		gameplay_controller->initialize();
+		applyInputOptions();
 		collection_controller->initialize();
+
+		if (CommandLineOptions::getNumberOfSticks() > 0) collection_controller->setNumberOfElements(CommandLineOptions::getNumberOfSticks());
+		if (CommandLineOptions::getInputFile()) collection_controller->loadInputFile(CommandLineOptions::getInputFile());
+	}
+
+	void GameplayService::applyInputOptions()
+	{
+		InputDistribution distribution;
+		const char* distribution_name = CommandLineOptions::getInputDistribution();
+
+		if (distribution_name && InputGenerator::parseDistribution(distribution_name, distribution)) collection_controller->setInputDistribution(distribution);
+		else if (distribution_name) printf("Ignoring unknown distribution %s\n", distribution_name);
+
+		if (CommandLineOptions::hasInputSeed()) collection_controller->setInputSeed(CommandLineOptions::getInputSeed());
+		applyRaceOption();
+	}
+
+	// --race is a comma separated list of SortTypeInfo option names; an invalid list keeps the default lanes.
+	void GameplayService::applyRaceOption()
+	{
+		const char* race_option = CommandLineOptions::getRaceSortTypes();
+		if (!race_option) return;
+
+		std::vector<SortType> sort_types;
+		std::string names(race_option);
+		for (std::size_t first = 0; first <= names.size(); )
+		{
+			std::size_t last = std::min(names.find(',', first), names.size());
+			std::string name = names.substr(first, last - first);
+			first = last + 1;
+
+			int sort_type = 0;
+			while (sort_type < static_cast<int>(SortType::COUNT) && name != getSortTypeInfo(static_cast<SortType>(sort_type)).option_name) sort_type++;
+			if (sort_type == static_cast<int>(SortType::COUNT))
+			{
+				printf("Ignoring --race, unknown sort %s\n", name.c_str());
+				return;
+			}
+			sort_types.push_back(static_cast<SortType>(sort_type));
+		}
+
+		if (static_cast<int>(sort_types.size()) < min_race_lanes || static_cast<int>(sort_types.size()) > max_race_lanes)
+		{
+			printf("Ignoring --race, a race needs %d to %d sorts\n", min_race_lanes, max_race_lanes);
+			return;
+		}
+		race_sort_types = sort_types;
 	}
 
 	void GameplayService::update()
 	{
 		gameplay_controller->update();
-		collection_controller->update();
+
+		if (race_mode) updateRace();
+		else collection_controller->update();
 	}
 
 	void GameplayService::render()
 	{
 		gameplay_controller->render();
-		collection_controller->render();
+
+		if (race_mode) renderRace();
+		else collection_controller->render();
 	}
 
 	void GameplayService::reset()
 	{
 		gameplay_controller->reset();
 		collection_controller->reset();
+		destroyRace();
+	}
+
+	void GameplayService::startRace(const std::vector<Collection::SortType>& sort_types)
+	{
+		destroyRace();
+
+		int lane_count = std::min(static_cast<int>(sort_types.size()), max_race_lanes);
+		if (lane_count < min_race_lanes)
+		{
+			printf("A race needs at least %d algorithms\n", min_race_lanes);
+			return;
+		}
+
+		race_mode = true;
+
+		int columns = lane_count > 4 ? 2 : 1;
+		int rows = (lane_count + columns - 1) / columns;
+		float lane_width = (ServiceLocator::getInstance()->getGraphicService()->getGameWindow()->getSize().x - (columns + 1) * race_lane_spacing) / columns;
+		float row_height = (race_area_bottom - race_area_top) / rows;
+
+		for (int i = 0; i < lane_count; i++)
+		{
+			float lane_x = race_lane_spacing + (i % columns) * (lane_width + race_lane_spacing);
+			float lane_y = race_area_top + (i / columns) * row_height + race_lane_label_height;
+
+			StickCollectionController* lane = new StickCollectionController();
+			lane->setInputDistribution(collection_controller->getInputDistribution());
+			lane->setInputSeed(collection_controller->getInputSeed());
+			lane->setStableSortMode(collection_controller->isStableSortMode());
+			lane->initialize();
+			if (collection_controller->getInputValues()) lane->setInputValues(collection_controller->getInputValues());
+			else lane->setNumberOfElements(collection_controller->getNumberOfSticks());
+			lane->setRaceLaneIndex(i);
+			lane->setLaneBounds(sf::FloatRect(lane_x, lane_y, lane_width, row_height - race_lane_label_height - race_lane_spacing));
+			race_controllers.push_back(lane);
+		}
+
+		for (int i = 0; i < lane_count; i++) race_controllers[i]->sortElements(sort_types[i]);
 	}
 
+	void GameplayService::setNumberOfSticks(int number_of_sticks)
+	{
+		collection_controller->setNumberOfElements(number_of_sticks);
+	}
+
+	void GameplayService::updateRace()
+	{
+		for (StickCollectionController* lane : race_controllers)
+		{
+			lane->update();
+
+			if (lane->getFinishPlace() == 0 && lane->isSortCompleted())
+			{
+				race_finish_order.push_back(lane->getSortType());
+				lane->setFinishPlace(static_cast<int>(race_finish_order.size()));
+			}
+		}
+	}
+
+	void GameplayService::renderRace()
+	{
+		// Lanes lay out their own vertices on the worker pool; the shared batch is then filled in lane order.
+		Threading::TaskGroup lane_tasks;
+		for (StickCollectionController* lane : race_controllers) lane_tasks.run([lane]() { lane->prepareStickVertices(); });
+		lane_tasks.wait();
+
+		race_stick_batch.clear();
+		for (StickCollectionController* lane : race_controllers) lane->appendSticksToBatch(race_stick_batch);
+
+		ServiceLocator::getInstance()->getGraphicService()->getGameWindow()->draw(race_stick_batch);
+		ServiceLocator::getInstance()->getProfilingService()->recordDrawCall();
+
+		for (StickCollectionController* lane : race_controllers) lane->renderLaneLabel();
+	}
+
+	void GameplayService::destroyRace()
+	{
+		for (StickCollectionController* lane : race_controllers) delete (lane);
+		race_controllers.clear();
+		race_finish_order.clear();
+		race_mode = false;
+	}
+
+	bool GameplayService::isRaceMode() { return race_mode; }
+
+	int GameplayService::getRaceLaneCount() { return static_cast<int>(race_controllers.size()); }
+
+	const std::vector<Collection::SortType>& GameplayService::getRaceSortTypes() { return race_sort_types; }
+
+	const std::vector<Collection::SortType>& GameplayService::getRaceFinishOrder() { return race_finish_order; }
+
 	void GameplayService::sortElement(Collection::SortType sort_type)
 	{
 		collection_controller->sortElements(sort_type);
@@ -53,12 +206,12 @@ namespace Gameplay
 		return collection_controller->getSortType();
 	}
 
-	int GameplayService::getNumberOfComparisons()
+	long long GameplayService::getNumberOfComparisons()
 	{
 		return collection_controller->getNumberOfComparisons();
 	}
 
-	int GameplayService::getNumberOfArrayAccess()
+	long long GameplayService::getNumberOfArrayAccess()
 	{
 		return collection_controller->getNumberOfArrayAccess();
 	}
@@ -73,8 +226,18 @@ namespace Gameplay
 		return collection_controller->getDelayMilliseconds();
 	}
 
-	sf::String GameplayService::getTimeComplexity()
+	const sf::String& GameplayService::getTimeComplexity()
 	{
 		return collection_controller->getTimeComplexity();
 	}
+
+	bool GameplayService::isStableSort()
+	{
+		return collection_controller->isStableSort();
+	}
+
+	Sorting::StabilityCheck GameplayService::getStabilityCheck()
+	{
+		return collection_controller->getStabilityCheck();
+	}
 }
\ No newline at end of file
@@ -0,0 +1,143 @@
+#include "Global/CommandLineOptions.h"
+#include <cerrno>
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace Global
+{
+	int CommandLineOptions::number_of_sticks = 0;
+	const char* CommandLineOptions::input_distribution = nullptr;
+	const char* CommandLineOptions::input_file = nullptr;
+	const char* CommandLineOptions::external_sort_input = nullptr;
+	const char* CommandLineOptions::output_file = nullptr;
+	int CommandLineOptions::memory_budget_mib = 256;
+	int CommandLineOptions::number_of_threads = 0;
+	const char* CommandLineOptions::numa_policy = nullptr;
+	bool CommandLineOptions::pin_threads = false;
+	bool CommandLineOptions::huge_pages = true;
+	const char* CommandLineOptions::benchmark = nullptr;
+	const char* CommandLineOptions::race_sort_types = nullptr;
+	bool CommandLineOptions::has_input_seed = false;
+	std::uint64_t CommandLineOptions::input_seed = 0;
+
+	void CommandLineOptions::parse(int argc, char* argv[])
+	{
+		for (int i = 1; i < argc; i++)
+		{
+			const char* value = nullptr;
+			long long parsed_value = 0;
+
+			if (matchOption(argv[i], "--sticks", value))
+			{
+				if (parseInteger(value, 1, 1000000000, parsed_value)) number_of_sticks = static_cast<int>(parsed_value);
+				else printf("Ignoring invalid stick count %s\n", value);
+			}
+			else if (matchOption(argv[i], "--distribution", value))
+			{
+				input_distribution = value;
+			}
+			else if (matchOption(argv[i], "--input", value))
+			{
+				input_file = value;
+			}
+			else if (matchOption(argv[i], "--external-sort", value))
+			{
+				external_sort_input = value;
+			}
+			else if (matchOption(argv[i], "--output", value))
+			{
+				output_file = value;
+			}
+			else if (matchOption(argv[i], "--memory", value))
+			{
+				if (parseInteger(value, 1, 1 << 20, parsed_value)) memory_budget_mib = static_cast<int>(parsed_value);
+				else printf("Ignoring invalid memory budget %s\n", value);
+			}
+			else if (matchOption(argv[i], "--threads", value))
+			{
+				if (parseInteger(value, 1, 1024, parsed_value)) number_of_threads = static_cast<int>(parsed_value);
+				else printf("Ignoring invalid thread count %s\n", value);
+			}
+			else if (matchOption(argv[i], "--numa", value))
+			{
+				numa_policy = value;
+			}
+			else if (matchOption(argv[i], "--pin-threads", value))
+			{
+				if (parseInteger(value, 0, 1, parsed_value)) pin_threads = parsed_value != 0;
+				else printf("Ignoring invalid thread pinning %s, use 0 or 1\n", value);
+			}
+			else if (matchOption(argv[i], "--huge-pages", value))
+			{
+				if (parseInteger(value, 0, 1, parsed_value)) huge_pages = parsed_value != 0;
+				else printf("Ignoring invalid huge pages setting %s, use 0 or 1\n", value);
+			}
+			else if (matchOption(argv[i], "--benchmark", value))
+			{
+				benchmark = value;
+			}
+			else if (matchOption(argv[i], "--race", value))
+			{
+				race_sort_types = value;
+			}
+			else if (matchOption(argv[i], "--seed", value))
+			{
+				has_input_seed = parseInteger(value, 0, LLONG_MAX, parsed_value);
+				if (has_input_seed) input_seed = static_cast<std::uint64_t>(parsed_value);
+				else printf("Ignoring invalid seed %s\n", value);
+			}
+			else
+			{
+				printf("Ignoring unknown option %s\n", argv[i]);
+			}
+		}
+	}
+
+	bool CommandLineOptions::matchOption(const char* argument, const char* name, const char*& value)
+	{
+		std::size_t name_length = std::strlen(name);
+		if (std::strncmp(argument, name, name_length) != 0 || argument[name_length] != '=') return false;
+
+		value = argument + name_length + 1;
+		return true;
+	}
+
+	bool CommandLineOptions::parseInteger(const char* text, long long min_value, long long max_value, long long& value)
+	{
+		char* end = nullptr;
+		errno = 0;
+		value = std::strtoll(text, &end, 10);
+
+		return end != text && *end == '\0' && errno == 0 && value >= min_value && value <= max_value;
+	}
+
+	int CommandLineOptions::getNumberOfSticks() { return number_of_sticks; }
+
+	const char* CommandLineOptions::getInputDistribution() { return input_distribution; }
+
+	const char* CommandLineOptions::getInputFile() { return input_file; }
+
+	const char* CommandLineOptions::getExternalSortInput() { return external_sort_input; }
+
+	const char* CommandLineOptions::getOutputFile() { return output_file; }
+
+	int CommandLineOptions::getMemoryBudgetMiB() { return memory_budget_mib; }
+
+	int CommandLineOptions::getNumberOfThreads() { return number_of_threads; }
+
+	const char* CommandLineOptions::getNumaPolicy() { return numa_policy; }
+
+	bool CommandLineOptions::getPinThreads() { return pin_threads; }
+
+	bool CommandLineOptions::getHugePages() { return huge_pages; }
+
+	const char* CommandLineOptions::getBenchmark() { return benchmark; }
+
+	const char* CommandLineOptions::getRaceSortTypes() { return race_sort_types; }
+
+	bool CommandLineOptions::hasInputSeed() { return has_input_seed; }
+
+	std::uint64_t CommandLineOptions::getInputSeed() { return input_seed; }
+}
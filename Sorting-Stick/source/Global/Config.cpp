@@ -20,11 +20,13 @@ namespace Global
 
 	const sf::String Config::quit_button_texture_path = "assets/textures/quit_button.png";
 
+	const sf::String Config::play_button_texture_path = "assets/textures/play_button.png";
+
 	const sf::String Config::menu_button_large_texture_path = "assets/textures/menu_button_large.png";
 
 	const sf::String Config::bubble_bobble_font_path = "assets/fonts/bubbleBobble.ttf";
 
-	const sf::String Config::DS_DIGIB_font_path = "assets/fonts/DS_DIGIB.ttf";
+	const sf::String Config::DS_DIGIB_font_path = "assets/fonts/DS_DIGIB.TTF";
 
 	const sf::String Config::compare_sfx_sound_path = "assets/sounds/compare_sfx.wav";
 
@@ -0,0 +1,247 @@
+#include "Global/HugePageArena.h"
+#include <algorithm>
+#include <cstdint>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace Global
+{
+	namespace
+	{
+		std::size_t roundUp(std::size_t bytes, std::size_t alignment) { return (bytes + alignment - 1) / alignment * alignment; }
+
+#ifdef _WIN32
+		// Large pages can only be allocated once SeLockMemoryPrivilege, granted through the local
+		// security policy, is enabled in the process token.
+		bool enableLockMemoryPrivilege()
+		{
+			HANDLE token = nullptr;
+			if (!OpenProcessToken(GetCurrentProcess(), TOKEN_ADJUST_PRIVILEGES | TOKEN_QUERY, &token)) return false;
+
+			TOKEN_PRIVILEGES privileges = {};
+			privileges.PrivilegeCount = 1;
+			privileges.Privileges[0].Attributes = SE_PRIVILEGE_ENABLED;
+			bool enabled = LookupPrivilegeValueA(nullptr, "SeLockMemoryPrivilege", &privileges.Privileges[0].Luid)
+				&& AdjustTokenPrivileges(token, FALSE, &privileges, 0, nullptr, nullptr) && GetLastError() == ERROR_SUCCESS;
+
+			CloseHandle(token);
+			return enabled;
+		}
+#endif
+	}
+
+	HugePageArena::HugePageArena()
+	{
+		huge_pages_enabled = true;
+		explicit_huge_pages_failed = false;
+		stats = { 0, 0, 0, 0 };
+
+#ifdef _WIN32
+		SYSTEM_INFO system_info;
+		GetSystemInfo(&system_info);
+		page_bytes = system_info.dwPageSize;
+		huge_page_bytes = GetLargePageMinimum();
+		if (huge_page_bytes == 0 || !enableLockMemoryPrivilege()) explicit_huge_pages_failed = true;
+		if (huge_page_bytes == 0) huge_page_bytes = 2 << 20;
+#else
+		page_bytes = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+		huge_page_bytes = 2 << 20;
+#endif
+	}
+
+	HugePageArena::~HugePageArena()
+	{
+		for (auto& block : blocks) unmapBlock(block.first, block.second);
+	}
+
+	HugePageArena* HugePageArena::getInstance()
+	{
+		static HugePageArena instance;
+		return &instance;
+	}
+
+	void HugePageArena::setHugePagesEnabled(bool enabled)
+	{
+		std::lock_guard<std::mutex> lock(arena_mutex);
+		huge_pages_enabled = enabled;
+		trimLocked();
+	}
+
+	bool HugePageArena::areHugePagesEnabled()
+	{
+		std::lock_guard<std::mutex> lock(arena_mutex);
+		return huge_pages_enabled;
+	}
+
+	void* HugePageArena::allocate(std::size_t bytes, bool& fresh)
+	{
+		std::lock_guard<std::mutex> lock(arena_mutex);
+
+		bool huge_block = huge_pages_enabled && bytes >= min_huge_page_block_bytes;
+		bytes = roundUp(std::max<std::size_t>(bytes, 1), huge_block ? huge_page_bytes : page_bytes);
+
+		// Best fit among the cached blocks, but never one more than twice the size asked for.
+		auto cached = cached_blocks.lower_bound(bytes);
+		if (cached != cached_blocks.end() && cached->first <= 2 * bytes)
+		{
+			void* memory = cached->second;
+			stats.cached_bytes -= cached->first;
+			cached_blocks.erase(cached);
+
+			stats.reused_allocations++;
+			fresh = false;
+			return memory;
+		}
+
+		PageBacking backing = PageBacking::NORMAL_PAGES;
+		void* memory = mapBlock(bytes, backing);
+		if (!memory) return nullptr;
+
+		blocks[memory] = { bytes, backing };
+		stats.mapped_bytes += bytes;
+		stats.fresh_allocations++;
+		fresh = true;
+		return memory;
+	}
+
+	void HugePageArena::release(void* memory)
+	{
+		if (!memory) return;
+		std::lock_guard<std::mutex> lock(arena_mutex);
+
+		auto block = blocks.find(memory);
+		if (block == blocks.end()) return;
+
+		if (stats.cached_bytes + block->second.bytes <= max_cached_bytes)
+		{
+			cached_blocks.emplace(block->second.bytes, memory);
+			stats.cached_bytes += block->second.bytes;
+			return;
+		}
+
+		unmapBlock(memory, block->second);
+		stats.mapped_bytes -= block->second.bytes;
+		blocks.erase(block);
+	}
+
+	void HugePageArena::trim()
+	{
+		std::lock_guard<std::mutex> lock(arena_mutex);
+		trimLocked();
+	}
+
+	void HugePageArena::trimLocked()
+	{
+		for (auto& cached : cached_blocks)
+		{
+			auto block = blocks.find(cached.second);
+			unmapBlock(block->first, block->second);
+			stats.mapped_bytes -= block->second.bytes;
+			blocks.erase(block);
+		}
+		cached_blocks.clear();
+		stats.cached_bytes = 0;
+	}
+
+	PageBacking HugePageArena::getPageBacking(const void* memory)
+	{
+		std::lock_guard<std::mutex> lock(arena_mutex);
+		auto block = blocks.find(const_cast<void*>(memory));
+		return block != blocks.end() ? block->second.backing : PageBacking::NORMAL_PAGES;
+	}
+
+	HugePageArenaStats HugePageArena::getStats()
+	{
+		std::lock_guard<std::mutex> lock(arena_mutex);
+		return stats;
+	}
+
+	const char* HugePageArena::getPageBackingName(PageBacking backing)
+	{
+		switch (backing)
+		{
+		case PageBacking::NORMAL_PAGES:
+			return "normal pages";
+		case PageBacking::TRANSPARENT_HUGE_PAGES:
+			return "transparent huge pages";
+		case PageBacking::HUGE_PAGES:
+			return "huge pages";
+		}
+		return "";
+	}
+
+	// Explicit huge pages are only tried until the first failure: without a reserved pool every
+	// attempt fails, and each one costs a system call.
+	void* HugePageArena::mapBlock(std::size_t bytes, PageBacking& backing)
+	{
+		bool huge_block = huge_pages_enabled && bytes >= min_huge_page_block_bytes;
+
+#ifdef _WIN32
+		if (huge_block && !explicit_huge_pages_failed)
+		{
+			void* memory = VirtualAlloc(nullptr, bytes, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE);
+			if (memory)
+			{
+				backing = PageBacking::HUGE_PAGES;
+				return memory;
+			}
+			explicit_huge_pages_failed = true;
+		}
+
+		backing = PageBacking::NORMAL_PAGES;
+		return VirtualAlloc(nullptr, bytes, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+#else
+#ifdef MAP_HUGETLB
+		if (huge_block && !explicit_huge_pages_failed)
+		{
+			void* memory = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+			if (memory != MAP_FAILED)
+			{
+				backing = PageBacking::HUGE_PAGES;
+				return memory;
+			}
+			explicit_huge_pages_failed = true;
+		}
+#endif
+
+		backing = PageBacking::NORMAL_PAGES;
+		if (!huge_block)
+		{
+			void* memory = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+			return memory != MAP_FAILED ? memory : nullptr;
+		}
+
+		// Transparent huge pages only back 2 MiB aligned ranges, so map one extra huge page and cut
+		// the unaligned ends off.
+		std::size_t mapped_bytes = bytes + huge_page_bytes;
+		char* mapping = static_cast<char*>(mmap(nullptr, mapped_bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+		if (mapping == MAP_FAILED) return nullptr;
+
+		char* memory = reinterpret_cast<char*>(roundUp(reinterpret_cast<std::uintptr_t>(mapping), huge_page_bytes));
+		if (memory > mapping) munmap(mapping, memory - mapping);
+		if (memory + bytes < mapping + mapped_bytes) munmap(memory + bytes, mapping + mapped_bytes - (memory + bytes));
+
+#ifdef MADV_HUGEPAGE
+		if (madvise(memory, bytes, MADV_HUGEPAGE) == 0) backing = PageBacking::TRANSPARENT_HUGE_PAGES;
+#endif
+		return memory;
+#endif
+	}
+
+	void HugePageArena::unmapBlock(void* memory, const Block& block)
+	{
+#ifdef _WIN32
+		VirtualFree(memory, 0, MEM_RELEASE);
+#else
+		munmap(memory, block.bytes);
+#endif
+	}
+}
@@ -0,0 +1,114 @@
+#include "Global/MemoryMappedFile.h"
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Global
+{
+#ifdef _WIN32
+	MemoryMappedFile::MemoryMappedFile() : data(nullptr), size(0), file_handle(INVALID_HANDLE_VALUE), mapping_handle(nullptr) { }
+#else
+	MemoryMappedFile::MemoryMappedFile() : data(nullptr), size(0), file_descriptor(-1) { }
+#endif
+
+	MemoryMappedFile::~MemoryMappedFile() { close(); }
+
+#ifdef _WIN32
+	bool MemoryMappedFile::open(const std::string& file_path)
+	{
+		close();
+
+		file_handle = CreateFileA(file_path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+		if (file_handle == INVALID_HANDLE_VALUE) return false;
+
+		LARGE_INTEGER file_size;
+		if (!GetFileSizeEx(file_handle, &file_size) || file_size.QuadPart == 0)
+		{
+			close();
+			return false;
+		}
+
+		mapping_handle = CreateFileMappingA(file_handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (!mapping_handle)
+		{
+			close();
+			return false;
+		}
+
+		data = static_cast<const unsigned char*>(MapViewOfFile(mapping_handle, FILE_MAP_READ, 0, 0, 0));
+		if (!data)
+		{
+			close();
+			return false;
+		}
+
+		size = static_cast<std::size_t>(file_size.QuadPart);
+		return true;
+	}
+
+	void MemoryMappedFile::close()
+	{
+		if (data) UnmapViewOfFile(data);
+		if (mapping_handle) CloseHandle(mapping_handle);
+		if (file_handle != INVALID_HANDLE_VALUE) CloseHandle(file_handle);
+
+		data = nullptr;
+		size = 0;
+		mapping_handle = nullptr;
+		file_handle = INVALID_HANDLE_VALUE;
+	}
+
+	// The file is already opened with FILE_FLAG_SEQUENTIAL_SCAN, which covers mapped reads too.
+	void MemoryMappedFile::adviseSequentialAccess() { }
+#else
+	bool MemoryMappedFile::open(const std::string& file_path)
+	{
+		close();
+
+		file_descriptor = ::open(file_path.c_str(), O_RDONLY);
+		if (file_descriptor < 0) return false;
+
+		struct stat file_status;
+		if (fstat(file_descriptor, &file_status) != 0 || file_status.st_size == 0)
+		{
+			close();
+			return false;
+		}
+
+		void* mapping = mmap(nullptr, static_cast<std::size_t>(file_status.st_size), PROT_READ, MAP_PRIVATE, file_descriptor, 0);
+		if (mapping == MAP_FAILED)
+		{
+			close();
+			return false;
+		}
+
+		data = static_cast<const unsigned char*>(mapping);
+		size = static_cast<std::size_t>(file_status.st_size);
+		return true;
+	}
+
+	void MemoryMappedFile::close()
+	{
+		if (data) munmap(const_cast<unsigned char*>(data), size);
+		if (file_descriptor >= 0) ::close(file_descriptor);
+
+		data = nullptr;
+		size = 0;
+		file_descriptor = -1;
+	}
+
+	void MemoryMappedFile::adviseSequentialAccess()
+	{
+		if (data) madvise(const_cast<unsigned char*>(data), size, MADV_SEQUENTIAL);
+	}
+#endif
+}
@@ -1,5 +1,8 @@
 #include "Global/ServiceLocator.h"
 #include "Main/GameService.h"
+#include "Profiling/TraceRecorder.h"
+#include "Global/CommandLineOptions.h"
+#include "Threading/NumaMemory.h"
 
 namespace Global
 {
@@ -9,6 +12,9 @@ namespace Global
 	using namespace UI;
 	using namespace Gameplay;
 	using namespace Main;
+	using namespace Profiling;
+	using namespace Resource;
+	using namespace Threading;
 
 	ServiceLocator::ServiceLocator()
 	{
@@ -17,6 +23,10 @@ namespace Global
 		sound_service = nullptr;
 		ui_service = nullptr;
 		gameplay_service = nullptr;
+		profiling_service = nullptr;
+		resource_service = nullptr;
+		task_scheduler = nullptr;
+		asset_dependent_services_initialized = false;
 
 		createServices();
 	}
@@ -30,21 +40,44 @@ namespace Global
 		sound_service = new SoundService();
 		ui_service = new UIService();
 		gameplay_service = new GameplayService();
+		profiling_service = new ProfilingService();
+		resource_service = new ResourceService();
+		task_scheduler = TaskScheduler::getInstance();
 	}
 
 	void ServiceLocator::initialize()
 	{
+		// Started first: asset loading, input generation and rendering all hand work to the pool.
+		NumaMemory::initializeFromCommandLine();
+		task_scheduler->initialize(CommandLineOptions::getNumberOfThreads());
+		profiling_service->initialize();
 		graphic_service->initialize();
-		sound_service->initialize();
+		resource_service->initialize();
 		event_service->initialize();
 		ui_service->initialize();
+	}
+
+	// Called once the background asset loading has finished, while the splash screen is still animating.
+	void ServiceLocator::initializeAssetDependentServices()
+	{
+		sound_service->initialize();
+		ui_service->initializeAssetDependentControllers();
 		gameplay_service->initialize();
+
+		asset_dependent_services_initialized = true;
 	}
 
 	void ServiceLocator::update()
 	{
+		TRACE_SCOPE("ServiceLocator::update");
+
 		graphic_service->update();
 		event_service->update();
+		profiling_service->update();
+		resource_service->update();
+		sound_service->update();
+		if (!asset_dependent_services_initialized && resource_service->isLoadingComplete())
+			initializeAssetDependentServices();
 		if (GameService::getGameState() == GameState::GAMEPLAY)
 			gameplay_service->update();
 		ui_service->update();
@@ -58,6 +91,8 @@ namespace Global
 		ui_service->render();
 	}
 
+	bool ServiceLocator::areAssetsReady() { return asset_dependent_services_initialized; }
+
 	void ServiceLocator::clearAllServices()
 	{
 		delete(ui_service);
@@ -65,6 +100,9 @@ namespace Global
 		delete(sound_service);
 		delete(event_service);
 		delete(gameplay_service);
+		delete(profiling_service);
+		delete(resource_service);
+		task_scheduler->destroy();
 	}
 
 	ServiceLocator* ServiceLocator::getInstance()
@@ -83,5 +121,11 @@ namespace Global
 
 	GameplayService* ServiceLocator::getGameplayService() { return gameplay_service; }
 
+	ProfilingService* ServiceLocator::getProfilingService() { return profiling_service; }
+
+	ResourceService* ServiceLocator::getResourceService() { return resource_service; }
+
+	TaskScheduler* ServiceLocator::getTaskScheduler() { return task_scheduler; }
+
 	
 }
\ No newline at end of file
@@ -2,6 +2,7 @@
 #include "Graphics/GraphicService.h"
 #include "Event/EventService.h"
 #include "UI/UIService.h"
+#include "Profiling/TraceRecorder.h"
 
 namespace Main
 {
@@ -42,17 +43,24 @@ namespace Main
 	// Main Game Loop.
 	void GameService::update()
 	{
+		TRACE_SCOPE("GameService::update");
+		service_locator->getProfilingService()->beginFrame();
+
 		// Process Events.
 		service_locator->getEventService()->processEvents();
 
 		// Update Game Logic.
 		service_locator->update();
+		service_locator->getProfilingService()->endUpdate();
 	}
 
 	void GameService::render()
 	{
+		TRACE_SCOPE("GameService::render");
+
 		game_window->clear();
 		service_locator->render();
+		service_locator->getProfilingService()->endRender();
 		game_window->display();
 	}
 
@@ -0,0 +1,120 @@
+#include "Profiling/ProfilingService.h"
+#include "Profiling/TraceRecorder.h"
+#include "Global/ServiceLocator.h"
+#include "Event/EventService.h"
+#include <fstream>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace Profiling
+{
+	using namespace Global;
+
+	ProfilingService::ProfilingService()
+	{
+		trace_dump_count = 0;
+		frame_history_index = 0;
+		frame_time_ms = 0.f;
+		update_time_ms = 0.f;
+		render_time_ms = 0.f;
+		draw_calls_this_frame = 0;
+		draw_calls_last_frame = 0;
+
+		for (int i = 0; i < frame_history_size; i++) frame_times_ms[i] = 0.f;
+	}
+
+	ProfilingService::~ProfilingService()
+	{
+#ifdef SORTING_STICK_ENABLE_TRACE
+		dumpTrace();
+#endif
+	}
+
+	void ProfilingService::initialize()
+	{
+		TRACE_THREAD_NAME("main_thread");
+		frame_clock.restart();
+	}
+
+	void ProfilingService::update()
+	{
+#ifdef SORTING_STICK_ENABLE_TRACE
+		if (ServiceLocator::getInstance()->getEventService()->pressedF9Key()) dumpTrace();
+#endif
+	}
+
+	void ProfilingService::dumpTrace()
+	{
+		if (TraceRecorder::getRecordedEventCount() == 0) return;
+
+		TraceRecorder::dumpChromeTrace(trace_file_prefix + std::to_string(trace_dump_count) + ".json");
+		trace_dump_count++;
+	}
+
+	void ProfilingService::beginFrame()
+	{
+		frame_time_ms = frame_clock.restart().asMicroseconds() / 1000.f;
+		frame_times_ms[frame_history_index] = frame_time_ms;
+		frame_history_index = (frame_history_index + 1) % frame_history_size;
+
+		draw_calls_last_frame = draw_calls_this_frame;
+		draw_calls_this_frame = 0;
+
+		phase_clock.restart();
+	}
+
+	void ProfilingService::endUpdate()
+	{
+		update_time_ms = phase_clock.restart().asMicroseconds() / 1000.f;
+	}
+
+	void ProfilingService::endRender()
+	{
+		render_time_ms = phase_clock.restart().asMicroseconds() / 1000.f;
+	}
+
+	float ProfilingService::getFrameTimeMilliseconds() { return frame_time_ms; }
+
+	float ProfilingService::getUpdateTimeMilliseconds() { return update_time_ms; }
+
+	float ProfilingService::getRenderTimeMilliseconds() { return render_time_ms; }
+
+	int ProfilingService::getDrawCallCount() { return draw_calls_last_frame; }
+
+	void ProfilingService::getFrameTimeHistogram(int* bucket_counts, int bucket_count, float bucket_width_ms)
+	{
+		for (int i = 0; i < bucket_count; i++) bucket_counts[i] = 0;
+
+		for (int i = 0; i < frame_history_size; i++)
+		{
+			if (frame_times_ms[i] <= 0.f) continue;
+
+			int bucket = static_cast<int>(frame_times_ms[i] / bucket_width_ms);
+			if (bucket >= bucket_count) bucket = bucket_count - 1;
+			bucket_counts[bucket]++;
+		}
+	}
+
+	std::size_t ProfilingService::getProcessMemoryBytes()
+	{
+#ifdef _WIN32
+		PROCESS_MEMORY_COUNTERS counters;
+		if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) return counters.WorkingSetSize;
+		return 0;
+#else
+		std::ifstream statm("/proc/self/statm");
+		std::size_t total_pages = 0;
+		std::size_t resident_pages = 0;
+		if (!(statm >> total_pages >> resident_pages)) return 0;
+		return resident_pages * static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+#endif
+	}
+}
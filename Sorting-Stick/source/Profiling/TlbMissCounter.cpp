@@ -0,0 +1,84 @@
+#include "Profiling/TlbMissCounter.h"
+
+#ifdef __linux__
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace Profiling
+{
+#ifdef __linux__
+	namespace
+	{
+		int openTlbMissEvent(unsigned long long operation)
+		{
+			perf_event_attr attributes;
+			std::memset(&attributes, 0, sizeof(attributes));
+			attributes.type = PERF_TYPE_HW_CACHE;
+			attributes.size = sizeof(attributes);
+			attributes.config = PERF_COUNT_HW_CACHE_DTLB | (operation << 8) | (static_cast<unsigned long long>(PERF_COUNT_HW_CACHE_RESULT_MISS) << 16);
+			attributes.disabled = 1;
+			attributes.exclude_kernel = 1;
+			attributes.exclude_hv = 1;
+
+			return static_cast<int>(syscall(SYS_perf_event_open, &attributes, 0, -1, -1, 0));
+		}
+	}
+
+	TlbMissCounter::TlbMissCounter()
+	{
+		event_files[0] = openTlbMissEvent(PERF_COUNT_HW_CACHE_OP_READ);
+		event_files[1] = openTlbMissEvent(PERF_COUNT_HW_CACHE_OP_WRITE);
+	}
+
+	TlbMissCounter::~TlbMissCounter()
+	{
+		for (int event_file : event_files) if (event_file >= 0) close(event_file);
+	}
+
+	// Store misses are not counted separately on every CPU, loads alone still make the comparison.
+	bool TlbMissCounter::isAvailable() const { return event_files[0] >= 0; }
+
+	void TlbMissCounter::start()
+	{
+		for (int event_file : event_files)
+		{
+			if (event_file < 0) continue;
+			ioctl(event_file, PERF_EVENT_IOC_RESET, 0);
+			ioctl(event_file, PERF_EVENT_IOC_ENABLE, 0);
+		}
+	}
+
+	long long TlbMissCounter::stop()
+	{
+		if (!isAvailable()) return -1;
+
+		long long misses = 0;
+		for (int event_file : event_files)
+		{
+			if (event_file < 0) continue;
+			ioctl(event_file, PERF_EVENT_IOC_DISABLE, 0);
+
+			long long event_misses = 0;
+			if (read(event_file, &event_misses, sizeof(event_misses)) == sizeof(event_misses)) misses += event_misses;
+		}
+		return misses;
+	}
+#else
+	TlbMissCounter::TlbMissCounter()
+	{
+		for (int& event_file : event_files) event_file = -1;
+	}
+
+	TlbMissCounter::~TlbMissCounter() { }
+
+	bool TlbMissCounter::isAvailable() const { return false; }
+
+	void TlbMissCounter::start() { }
+
+	long long TlbMissCounter::stop() { return -1; }
+#endif
+}
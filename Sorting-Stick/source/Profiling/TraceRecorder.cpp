@@ -0,0 +1,100 @@
+#include "Profiling/TraceRecorder.h"
+#include <cstdio>
+#include <fstream>
+#include <algorithm>
+
+namespace Profiling
+{
+	TraceEvent TraceRecorder::ring_buffer[TraceRecorder::ring_capacity];
+	std::atomic<std::uint64_t> TraceRecorder::write_index(0);
+
+	std::atomic<const char*> TraceRecorder::thread_names[TraceRecorder::max_thread_names] = { };
+	std::atomic<std::uint32_t> TraceRecorder::next_thread_id(0);
+
+	const std::chrono::steady_clock::time_point TraceRecorder::epoch_time = std::chrono::steady_clock::now();
+	const std::int64_t TraceRecorder::epoch_ticks = TraceRecorder::now();
+
+	std::uint32_t TraceRecorder::getThreadId()
+	{
+		thread_local std::uint32_t thread_id = next_thread_id.fetch_add(1, std::memory_order_relaxed);
+		return thread_id;
+	}
+
+	void TraceRecorder::setThreadName(const char* name)
+	{
+		std::uint32_t thread_id = getThreadId();
+		if (thread_id < max_thread_names) thread_names[thread_id].store(name, std::memory_order_release);
+	}
+
+	double TraceRecorder::getNanosecondsPerTick()
+	{
+#ifdef TRACE_HAS_TSC
+		// Calibrate the time-stamp counter against steady_clock over the whole recording.
+		std::int64_t elapsed_ticks = now() - epoch_ticks;
+		std::int64_t elapsed_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - epoch_time).count();
+		return elapsed_ticks > 0 ? static_cast<double>(elapsed_ns) / elapsed_ticks : 1.0;
+#else
+		return 1.0;
+#endif
+	}
+
+	std::uint64_t TraceRecorder::getRecordedEventCount()
+	{
+		return write_index.load(std::memory_order_relaxed);
+	}
+
+	bool TraceRecorder::dumpChromeTrace(const std::string& file_path)
+	{
+		std::ofstream file(file_path);
+		if (!file.is_open())
+		{
+			printf("Error writing trace file %s\n", file_path.c_str());
+			return false;
+		}
+
+		std::uint64_t end = write_index.load(std::memory_order_relaxed);
+		std::uint64_t begin = end > ring_capacity ? end - ring_capacity : 0;
+		double microseconds_per_tick = getNanosecondsPerTick() / 1000.0;
+
+		file << std::fixed;
+		file.precision(3);
+		file << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+
+		bool first = true;
+		std::uint32_t thread_count = std::min(next_thread_id.load(), max_thread_names);
+		for (std::uint32_t i = 0; i < thread_count; i++)
+		{
+			const char* thread_name = thread_names[i].load(std::memory_order_acquire);
+			if (!thread_name) continue;
+			file << (first ? "" : ",") << "\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << i
+				<< ",\"args\":{\"name\":\"" << thread_name << "\"}}";
+			first = false;
+		}
+
+		// The recording threads keep writing while this runs: a slot is only copied if its sequence names
+		// this event both before and after the copy, so half written or overwritten slots are skipped.
+		std::uint64_t written_events = 0;
+		for (std::uint64_t i = begin; i < end; i++)
+		{
+			const TraceEvent& event = ring_buffer[i & (ring_capacity - 1)];
+			if (event.sequence.load(std::memory_order_acquire) != i + 1) continue;
+
+			const char* name = event.name.load(std::memory_order_relaxed);
+			std::uint32_t thread_id = event.thread_id.load(std::memory_order_relaxed);
+			std::int64_t start_ticks = event.start_ticks.load(std::memory_order_relaxed);
+			std::int64_t duration_ticks = event.duration_ticks.load(std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_acquire);
+			if (event.sequence.load(std::memory_order_relaxed) != i + 1 || !name) continue;
+
+			file << (first ? "" : ",") << "\n{\"name\":\"" << name << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << thread_id
+				<< ",\"ts\":" << (start_ticks - epoch_ticks) * microseconds_per_tick
+				<< ",\"dur\":" << duration_ticks * microseconds_per_tick << "}";
+			first = false;
+			written_events++;
+		}
+
+		file << "\n]}\n";
+		printf("Wrote %llu trace events to %s\n", static_cast<unsigned long long>(written_events), file_path.c_str());
+		return true;
+	}
+}
@@ -0,0 +1,117 @@
+#include "Resource/AssetArchive.h"
+#include <cstdio>
+#include <cstring>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace Resource
+{
+	const char AssetArchive::archive_magic[4] = { 'S', 'S', 'P', 'K' };
+
+	const char* const AssetArchive::default_archive_name = "assets.pak";
+
+	namespace
+	{
+		bool readUint32(const unsigned char*& cursor, const unsigned char* end, std::uint32_t& value)
+		{
+			if (end - cursor < 4) return false;
+			value = static_cast<std::uint32_t>(cursor[0]) | static_cast<std::uint32_t>(cursor[1]) << 8 |
+				static_cast<std::uint32_t>(cursor[2]) << 16 | static_cast<std::uint32_t>(cursor[3]) << 24;
+			cursor += 4;
+			return true;
+		}
+
+		bool readUint64(const unsigned char*& cursor, const unsigned char* end, std::uint64_t& value)
+		{
+			std::uint32_t low, high;
+			if (!readUint32(cursor, end, low) || !readUint32(cursor, end, high)) return false;
+			value = static_cast<std::uint64_t>(high) << 32 | low;
+			return true;
+		}
+	}
+
+	std::string AssetArchive::getExecutableDirectory()
+	{
+		std::string executable_path;
+
+#ifdef _WIN32
+		char buffer[MAX_PATH];
+		DWORD length = GetModuleFileNameA(nullptr, buffer, MAX_PATH);
+		if (length > 0 && length < MAX_PATH) executable_path.assign(buffer, length);
+#else
+		char buffer[4096];
+		ssize_t length = readlink("/proc/self/exe", buffer, sizeof(buffer));
+		if (length > 0) executable_path.assign(buffer, static_cast<std::size_t>(length));
+#endif
+
+		std::size_t separator = executable_path.find_last_of("/\\");
+		if (separator == std::string::npos) return "";
+		return executable_path.substr(0, separator + 1);
+	}
+
+	bool AssetArchive::open(const std::string& archive_path)
+	{
+		close();
+		if (!archive_file.open(archive_path)) return false;
+
+		if (!readIndex())
+		{
+			printf("Ignoring invalid asset archive %s\n", archive_path.c_str());
+			close();
+			return false;
+		}
+
+		printf("Mapped asset archive %s (%zu assets)\n", archive_path.c_str(), entries.size());
+		return true;
+	}
+
+	bool AssetArchive::readIndex()
+	{
+		const unsigned char* begin = archive_file.getData();
+		const unsigned char* end = begin + archive_file.getSize();
+		const unsigned char* cursor = begin;
+
+		if (end - cursor < 4 || std::memcmp(cursor, archive_magic, 4) != 0) return false;
+		cursor += 4;
+
+		std::uint32_t version, entry_count;
+		if (!readUint32(cursor, end, version) || version != archive_version) return false;
+		if (!readUint32(cursor, end, entry_count)) return false;
+
+		for (std::uint32_t i = 0; i < entry_count; i++)
+		{
+			std::uint32_t path_length;
+			if (!readUint32(cursor, end, path_length) || static_cast<std::uint64_t>(end - cursor) < path_length) return false;
+
+			std::string path(reinterpret_cast<const char*>(cursor), path_length);
+			cursor += path_length;
+
+			std::uint64_t offset, size;
+			if (!readUint64(cursor, end, offset) || !readUint64(cursor, end, size)) return false;
+			if (offset > archive_file.getSize() || size > archive_file.getSize() - offset) return false;
+
+			entries[path] = AssetArchiveEntry{ begin + offset, static_cast<std::size_t>(size) };
+		}
+
+		return true;
+	}
+
+	void AssetArchive::close()
+	{
+		entries.clear();
+		archive_file.close();
+	}
+
+	const AssetArchiveEntry* AssetArchive::find(const std::string& asset_path) const
+	{
+		auto entry = entries.find(asset_path);
+		return entry == entries.end() ? nullptr : &entry->second;
+	}
+}
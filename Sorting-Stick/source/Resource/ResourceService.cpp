@@ -0,0 +1,278 @@
+#include "Resource/ResourceService.h"
+#include "Global/Config.h"
+#include <algorithm>
+#include <cstdio>
+
+namespace Resource
+{
+	using namespace Global;
+
+	ResourceService::ResourceService()
+	{
+		uploaded_asset_count = 0;
+		resources_loaded = 0;
+		total_load_time_ms = 0.f;
+	}
+
+	ResourceService::~ResourceService() { destroy(); }
+
+	void ResourceService::initialize()
+	{
+		openAssetArchive();
+
+		// The splash screen logo is not queued: it is needed for the first frame and is loaded on demand.
+		queueAsset(Config::background_texture_path, AssetType::TEXTURE);
+		queueAsset(Config::bubble_sort_button_texture_path, AssetType::TEXTURE);
+		queueAsset(Config::insertion_sort_button_texture_path, AssetType::TEXTURE);
+		queueAsset(Config::selection_sort_button_texture_path, AssetType::TEXTURE);
+		queueAsset(Config::merge_sort_button_texture_path, AssetType::TEXTURE);
+		queueAsset(Config::quick_sort_button_texture_path, AssetType::TEXTURE);
+		queueAsset(Config::radix_sort_button_texture_path, AssetType::TEXTURE);
+		queueAsset(Config::quit_button_texture_path, AssetType::TEXTURE);
+		queueAsset(Config::play_button_texture_path, AssetType::TEXTURE);
+		queueAsset(Config::menu_button_large_texture_path, AssetType::TEXTURE);
+
+		queueAsset(Config::bubble_bobble_font_path, AssetType::FONT);
+		queueAsset(Config::DS_DIGIB_font_path, AssetType::FONT);
+
+		queueAsset(Config::compare_sfx_sound_path, AssetType::SOUND_BUFFER);
+		queueAsset(Config::button_click_sound_path, AssetType::SOUND_BUFFER);
+
+		startLoaderTasks();
+	}
+
+	void ResourceService::openAssetArchive()
+	{
+		if (!asset_archive.open(AssetArchive::getExecutableDirectory() + AssetArchive::default_archive_name))
+			printf("No asset archive found, loading loose asset files\n");
+	}
+
+	// Fonts keep reading from the memory they were loaded from, which is fine: the archive
+	// stays mapped until every resource has been destroyed.
+	template<typename ResourceType>
+	bool ResourceService::loadResource(ResourceType* resource, const std::string& path)
+	{
+		const AssetArchiveEntry* entry = asset_archive.find(path);
+		if (entry) return resource->loadFromMemory(entry->data, entry->size);
+
+		return resource->loadFromFile(path);
+	}
+
+	void ResourceService::update()
+	{
+		if (isLoadingComplete()) return;
+
+		sf::Clock upload_clock;
+		for (PendingAsset* asset : pending_assets)
+		{
+			if (upload_clock.getElapsedTime().asMicroseconds() / 1000.f >= upload_budget_ms_per_frame) break;
+			if (!asset->uploaded && asset->decoded.load(std::memory_order_acquire)) uploadAsset(asset);
+		}
+
+		if (isLoadingComplete()) waitForLoaderTasks();
+	}
+
+	bool ResourceService::isLoadingComplete() { return uploaded_asset_count == pending_assets.size(); }
+
+	void ResourceService::queueAsset(const sf::String& path, AssetType type)
+	{
+		PendingAsset* asset = new PendingAsset();
+		asset->path = path.toAnsiString();
+		asset->type = type;
+
+		pending_assets.push_back(asset);
+		pending_assets_by_path[asset->path] = asset;
+	}
+
+	// One task per asset, so a thread that helps while waiting on the pool picks up at most one decode.
+	void ResourceService::startLoaderTasks()
+	{
+		for (PendingAsset* asset : pending_assets) loader_tasks.run([this, asset]() { decodeAsset(asset); });
+	}
+
+	// Runs on a pool worker: only CPU-side decoding, nothing that touches the GPU or audio device.
+	void ResourceService::decodeAsset(PendingAsset* asset)
+	{
+		sf::Clock decode_clock;
+
+		switch (asset->type)
+		{
+		case AssetType::TEXTURE:
+			asset->decode_succeeded = loadResource(&asset->image, asset->path);
+			break;
+
+		case AssetType::FONT:
+			asset->font = new sf::Font();
+			asset->decode_succeeded = loadResource(asset->font, asset->path);
+			break;
+
+		case AssetType::SOUND_BUFFER:
+		{
+			sf::InputSoundFile sound_file;
+			const AssetArchiveEntry* entry = asset_archive.find(asset->path);
+			asset->decode_succeeded = entry ? sound_file.openFromMemory(entry->data, entry->size) : sound_file.openFromFile(asset->path);
+			if (!asset->decode_succeeded) break;
+
+			asset->channel_count = sound_file.getChannelCount();
+			asset->sample_rate = sound_file.getSampleRate();
+			asset->samples.resize(static_cast<std::size_t>(sound_file.getSampleCount()));
+			asset->samples.resize(static_cast<std::size_t>(sound_file.read(asset->samples.data(), asset->samples.size())));
+			break;
+		}
+		}
+
+		asset->decode_time_ms = decode_clock.getElapsedTime().asMicroseconds() / 1000.f;
+		asset->decoded.store(true, std::memory_order_release);
+	}
+
+	// Runs on the main thread: moves a decoded asset into its cache.
+	void ResourceService::uploadAsset(PendingAsset* asset)
+	{
+		sf::Clock upload_clock;
+		bool succeeded = asset->decode_succeeded;
+
+		switch (asset->type)
+		{
+		case AssetType::TEXTURE:
+		{
+			sf::Texture* texture = nullptr;
+			if (succeeded)
+			{
+				texture = new sf::Texture();
+				succeeded = texture->loadFromImage(asset->image);
+				if (!succeeded)
+				{
+					delete (texture);
+					texture = nullptr;
+				}
+			}
+			textures[asset->path] = texture;
+			asset->image = sf::Image();
+			break;
+		}
+
+		case AssetType::FONT:
+			if (!succeeded)
+			{
+				delete (asset->font);
+				asset->font = nullptr;
+			}
+			fonts[asset->path] = asset->font;
+			break;
+
+		case AssetType::SOUND_BUFFER:
+		{
+			sf::SoundBuffer* sound_buffer = nullptr;
+			if (succeeded)
+			{
+				sound_buffer = new sf::SoundBuffer();
+				succeeded = sound_buffer->loadFromSamples(asset->samples.data(), asset->samples.size(), asset->channel_count, asset->sample_rate);
+				if (!succeeded)
+				{
+					delete (sound_buffer);
+					sound_buffer = nullptr;
+				}
+			}
+			sound_buffers[asset->path] = sound_buffer;
+			std::vector<sf::Int16>().swap(asset->samples);
+			break;
+		}
+		}
+
+		asset->uploaded = true;
+		uploaded_asset_count++;
+		reportLoad(asset->path, asset->decode_time_ms + upload_clock.getElapsedTime().asMicroseconds() / 1000.f, succeeded);
+	}
+
+	void ResourceService::finishPendingAsset(const std::string& path)
+	{
+		auto pending = pending_assets_by_path.find(path);
+		if (pending == pending_assets_by_path.end() || pending->second->uploaded) return;
+
+		// Help the pool while waiting: the decode may still be queued behind other tasks.
+		PendingAsset* asset = pending->second;
+		while (!asset->decoded.load(std::memory_order_acquire))
+		{
+			if (!Threading::TaskScheduler::getInstance()->runPendingTask()) std::this_thread::yield();
+		}
+
+		uploadAsset(asset);
+	}
+
+	void ResourceService::waitForLoaderTasks() { loader_tasks.wait(); }
+
+	template<typename ResourceType>
+	ResourceType* ResourceService::getOrLoad(std::unordered_map<std::string, ResourceType*>& cache, const sf::String& path)
+	{
+		std::string key = path.toAnsiString();
+		finishPendingAsset(key);
+
+		auto cached = cache.find(key);
+		if (cached != cache.end()) return cached->second;
+
+		sf::Clock load_clock;
+		ResourceType* resource = new ResourceType();
+		bool succeeded = loadResource(resource, key);
+		reportLoad(key, load_clock.getElapsedTime().asMicroseconds() / 1000.f, succeeded);
+
+		if (!succeeded)
+		{
+			delete (resource);
+			resource = nullptr;
+		}
+
+		// Failed loads are cached too, so a missing file is only hit once.
+		cache[key] = resource;
+		return resource;
+	}
+
+	void ResourceService::reportLoad(const std::string& path, float load_time_ms, bool succeeded)
+	{
+		if (!succeeded)
+		{
+			printf("Error loading resource %s\n", path.c_str());
+			return;
+		}
+
+		resources_loaded++;
+		total_load_time_ms += load_time_ms;
+		printf("Loaded %s in %.2f ms (%d resources, %.2f ms total)\n", path.c_str(), load_time_ms, resources_loaded, total_load_time_ms);
+	}
+
+	sf::Texture* ResourceService::getTexture(const sf::String& path) { return getOrLoad(textures, path); }
+
+	sf::Font* ResourceService::getFont(const sf::String& path) { return getOrLoad(fonts, path); }
+
+	sf::SoundBuffer* ResourceService::getSoundBuffer(const sf::String& path) { return getOrLoad(sound_buffers, path); }
+
+	int ResourceService::getLoadedResourceCount() { return resources_loaded; }
+
+	float ResourceService::getTotalLoadTimeMilliseconds() { return total_load_time_ms; }
+
+	template<typename ResourceType>
+	void ResourceService::clearCache(std::unordered_map<std::string, ResourceType*>& cache)
+	{
+		for (auto& entry : cache) delete (entry.second);
+		cache.clear();
+	}
+
+	void ResourceService::destroy()
+	{
+		// Loader tasks only ever touch pending assets, so let them finish before freeing anything.
+		waitForLoaderTasks();
+
+		for (PendingAsset* asset : pending_assets)
+		{
+			if (!asset->uploaded) delete (asset->font);
+			delete (asset);
+		}
+		pending_assets.clear();
+		pending_assets_by_path.clear();
+
+		clearCache(textures);
+		clearCache(fonts);
+		clearCache(sound_buffers);
+
+		asset_archive.close();
+	}
+}
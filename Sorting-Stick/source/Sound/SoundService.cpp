@@ -1,5 +1,8 @@
 #include "Sound/SoundService.h"
 #include "Global/Config.h"
+#include "Global/ServiceLocator.h"
+#include "Resource/ResourceService.h"
+#include "Event/EventService.h"
 
 namespace Sound
 {
@@ -18,29 +21,96 @@ namespace Sound
 
 	void SoundService::loadSoundFromFile()
 	{
-		if (!buffer_button_click.loadFromFile(Config::button_click_sound_path))
-			printf("Error loading background music file");
-		if (!buffer_compare_sfx.loadFromFile(Config::compare_sfx_sound_path)) {
-			printf("Error loading compare sfx file");
+		Resource::ResourceService* resource_service = ServiceLocator::getInstance()->getResourceService();
+
+		buffer_button_click = resource_service->getSoundBuffer(Config::button_click_sound_path);
+		buffer_compare_sfx = resource_service->getSoundBuffer(Config::compare_sfx_sound_path);
+	}
+
+	void SoundService::update()
+	{
+		if (ServiceLocator::getInstance()->getEventService()->pressedF4Key()) toggleSonification();
+
+		bool requested[sound_type_count] = { };
+
+		// Drain everything queued since the last frame; repeated requests of one type collapse into a single start.
+		SoundType sound_type;
+		while (sound_commands.pop(sound_type)) requested[static_cast<int>(sound_type)] = true;
+
+		int sounds_started = 0;
+		for (int i = 0; i < sound_type_count && sounds_started < max_sound_starts_per_frame; i++)
+		{
+			if (!requested[i]) continue;
+
+			startSound(static_cast<SoundType>(i));
+			sounds_started++;
 		}
 	}
 
-	void SoundService::playSound(SoundType soundType)
+	sf::SoundBuffer* SoundService::getSoundBuffer(SoundType sound_type)
 	{
-		switch (soundType)
+		switch (sound_type)
 		{
 		case SoundType::BUTTON_CLICK:
-			sound_effect.setBuffer(buffer_button_click);
-			break;
+			return buffer_button_click;
 		case SoundType::COMPARE_SFX:
-			sound_effect.setBuffer(buffer_compare_sfx);;
-			break;
+			return buffer_compare_sfx;
 		default:
 			printf("Invalid sound type");
-			return;
+			return nullptr;
+		}
+	}
+
+	// Returns an idle voice, or steals the one that has been playing the longest.
+	sf::Sound* SoundService::acquireVoice()
+	{
+		sf::Sound* oldest_voice = &voices[0];
+
+		for (int i = 0; i < voice_count; i++)
+		{
+			if (voices[i].getStatus() == sf::Sound::Stopped) return &voices[i];
+			if (voices[i].getPlayingOffset() > oldest_voice->getPlayingOffset()) oldest_voice = &voices[i];
 		}
 
-		sound_effect.play();
+		return oldest_voice;
+	}
+
+	void SoundService::startSound(SoundType sound_type)
+	{
+		sf::SoundBuffer* buffer = getSoundBuffer(sound_type);
+		if (!buffer) return;
+
+		sf::Sound* voice = acquireVoice();
+		voice->stop();
+		voice->setBuffer(*buffer);
+		voice->play();
+	}
+
+	void SoundService::toggleSonification()
+	{
+		sonification_enabled = !sonification_enabled;
+
+		if (sonification_enabled) tone_synthesizer.play();
+		else
+		{
+			// stop() joins the audio thread, so the queue can be drained here; tones already queued
+			// would otherwise burst out the next time sonification is turned on.
+			tone_synthesizer.stop();
+			tone_synthesizer.clearToneEvents();
+		}
+	}
+
+	// Safe to call from any thread; the sound starts on the next frame.
+	void SoundService::playSound(SoundType soundType)
+	{
+		sound_commands.push(soundType);
+	}
+
+	// Safe to call from any thread.
+	void SoundService::playCompareSound(int value, int max_value)
+	{
+		if (sonification_enabled && max_value > 0) tone_synthesizer.queueTone(static_cast<float>(value) / max_value);
+		else playSound(SoundType::COMPARE_SFX);
 	}
 
 	void SoundService::playBackgroundMusic()
@@ -49,4 +119,4 @@ namespace Sound
 		background_music.setVolume(background_music_volume);
 		background_music.play();
 	}
-}
\ No newline at end of file
+}
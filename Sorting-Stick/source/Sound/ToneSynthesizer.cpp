@@ -0,0 +1,119 @@
+#include "Sound/ToneSynthesizer.h"
+#include <algorithm>
+#include <cmath>
+
+namespace Sound
+{
+	namespace
+	{
+		const double two_pi = 6.283185307179586;
+	}
+
+	ToneSynthesizer::ToneSynthesizer()
+	{
+		events_in_last_chunk = 0;
+		initialize(1, sample_rate);
+	}
+
+	ToneSynthesizer::~ToneSynthesizer()
+	{
+		stop();
+	}
+
+	void ToneSynthesizer::queueTone(float normalized_value)
+	{
+		tone_events.push(normalized_value);
+	}
+
+	void ToneSynthesizer::clearToneEvents()
+	{
+		float normalized_value;
+		while (tone_events.pop(normalized_value)) { }
+	}
+
+	bool ToneSynthesizer::onGetData(Chunk& data)
+	{
+		consumeToneEvents();
+
+		for (int sample = 0; sample < chunk_sample_count; sample++)
+		{
+			float mixed = 0.f;
+
+			for (int i = 0; i < voice_count; i++)
+			{
+				Voice& voice = voices[i];
+				if (!voice.active) continue;
+
+				mixed += static_cast<float>(std::sin(voice.phase)) * getEnvelope(voice.elapsed_samples) * voice_amplitude;
+
+				voice.phase += voice.phase_increment;
+				if (voice.phase >= two_pi) voice.phase -= two_pi;
+				if (++voice.elapsed_samples >= tone_duration_samples) voice.active = false;
+			}
+
+			mixed = std::max(-1.f, std::min(1.f, mixed));
+			sample_buffer[sample] = static_cast<sf::Int16>(mixed * 32767.f);
+		}
+
+		data.samples = sample_buffer;
+		data.sampleCount = chunk_sample_count;
+		return true;
+	}
+
+	void ToneSynthesizer::onSeek(sf::Time) { }
+
+	// Keeps roughly every n-th event, where n is chosen from the previous chunk's event rate,
+	// so a burst of tens of thousands of events per second still maps to an even sweep of tones.
+	void ToneSynthesizer::consumeToneEvents()
+	{
+		int stride = std::max(1, events_in_last_chunk / max_new_voices_per_chunk);
+		int event_count = 0;
+		int started = 0;
+
+		float normalized_value;
+		while (tone_events.pop(normalized_value))
+		{
+			if (event_count % stride == 0 && started < max_new_voices_per_chunk)
+			{
+				startVoice(normalized_value);
+				started++;
+			}
+			event_count++;
+		}
+
+		events_in_last_chunk = event_count;
+	}
+
+	void ToneSynthesizer::startVoice(float normalized_value)
+	{
+		normalized_value = std::max(0.f, std::min(1.f, normalized_value));
+		double frequency = lowest_frequency * std::pow(2.0, normalized_value * octave_range);
+
+		Voice* voice = acquireVoice();
+		voice->active = true;
+		voice->phase = 0.0;
+		voice->phase_increment = two_pi * frequency / sample_rate;
+		voice->elapsed_samples = 0;
+	}
+
+	// An idle voice if there is one, otherwise the voice closest to the end of its tone.
+	ToneSynthesizer::Voice* ToneSynthesizer::acquireVoice()
+	{
+		Voice* oldest_voice = &voices[0];
+
+		for (int i = 0; i < voice_count; i++)
+		{
+			if (!voices[i].active) return &voices[i];
+			if (voices[i].elapsed_samples > oldest_voice->elapsed_samples) oldest_voice = &voices[i];
+		}
+
+		return oldest_voice;
+	}
+
+	// Short linear attack to avoid clicks, then a linear decay to silence.
+	float ToneSynthesizer::getEnvelope(int elapsed_samples)
+	{
+		if (elapsed_samples < attack_samples) return static_cast<float>(elapsed_samples) / attack_samples;
+		return 1.f - static_cast<float>(elapsed_samples - attack_samples) / (tone_duration_samples - attack_samples);
+	}
+}
@@ -0,0 +1,272 @@
+#include "Threading/NumaMemory.h"
+#include "Global/CommandLineOptions.h"
+#include "Global/HugePageArena.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <dlfcn.h>
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#endif
+
+namespace Threading
+{
+	using namespace Global;
+
+	namespace
+	{
+#ifndef _WIN32
+		// The few libnuma entry points we use, resolved with dlsym so libnuma stays optional.
+		struct NumaLibrary
+		{
+			void* handle = nullptr;
+			int (*numa_available)() = nullptr;
+			int (*numa_max_node)() = nullptr;
+			int (*numa_node_of_cpu)(int cpu) = nullptr;
+			void (*numa_interleave_memory)(void* start, std::size_t size, void* node_mask) = nullptr;
+			long (*numa_move_pages)(int pid, unsigned long count, void** pages, const int* nodes, int* status, int flags) = nullptr;
+			void** numa_all_nodes_ptr = nullptr;
+
+			bool load()
+			{
+				handle = dlopen("libnuma.so.1", RTLD_NOW | RTLD_LOCAL);
+				if (!handle) handle = dlopen("libnuma.so", RTLD_NOW | RTLD_LOCAL);
+				if (!handle) return false;
+
+				numa_available = reinterpret_cast<int (*)()>(dlsym(handle, "numa_available"));
+				numa_max_node = reinterpret_cast<int (*)()>(dlsym(handle, "numa_max_node"));
+				numa_node_of_cpu = reinterpret_cast<int (*)(int)>(dlsym(handle, "numa_node_of_cpu"));
+				numa_interleave_memory = reinterpret_cast<void (*)(void*, std::size_t, void*)>(dlsym(handle, "numa_interleave_memory"));
+				numa_move_pages = reinterpret_cast<long (*)(int, unsigned long, void**, const int*, int*, int)>(dlsym(handle, "numa_move_pages"));
+				numa_all_nodes_ptr = static_cast<void**>(dlsym(handle, "numa_all_nodes_ptr"));
+
+				if (numa_available && numa_max_node && numa_node_of_cpu && numa_available() >= 0) return true;
+
+				dlclose(handle);
+				*this = NumaLibrary();
+				return false;
+			}
+		};
+
+		NumaLibrary numa_library;
+#endif
+
+		// Pages looked up per range when counting placement, spread evenly over the range.
+		const std::size_t max_sampled_pages = 4096;
+
+		std::size_t getPageSize()
+		{
+#ifdef _WIN32
+			SYSTEM_INFO system_info;
+			GetSystemInfo(&system_info);
+			return system_info.dwPageSize;
+#else
+			return static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+#endif
+		}
+	}
+
+	NumaPolicy NumaMemory::policy = NumaPolicy::FIRST_TOUCH;
+	bool NumaMemory::thread_pinning = false;
+	bool NumaMemory::initialized = false;
+	int NumaMemory::node_count = 1;
+	std::vector<int> NumaMemory::pinning_cpus;
+
+	void NumaMemory::initializeFromCommandLine()
+	{
+		NumaPolicy requested_policy = NumaPolicy::FIRST_TOUCH;
+		const char* policy_name = CommandLineOptions::getNumaPolicy();
+		if (policy_name && !parsePolicy(policy_name, requested_policy)) printf("Ignoring unknown NUMA policy %s, available: off, first-touch, interleave\n", policy_name);
+
+		initialize(requested_policy, CommandLineOptions::getPinThreads());
+		HugePageArena::getInstance()->setHugePagesEnabled(CommandLineOptions::getHugePages());
+	}
+
+	void NumaMemory::initialize(NumaPolicy requested_policy, bool requested_thread_pinning)
+	{
+		if (!initialized) loadTopology();
+		initialized = true;
+
+		thread_pinning = requested_thread_pinning;
+		setPolicy(requested_policy);
+	}
+
+	bool NumaMemory::parsePolicy(const char* name, NumaPolicy& parsed_policy)
+	{
+		const NumaPolicy policies[] = { NumaPolicy::OFF, NumaPolicy::FIRST_TOUCH, NumaPolicy::INTERLEAVE };
+		for (NumaPolicy candidate : policies)
+		{
+			if (std::strcmp(name, getPolicyName(candidate)) != 0) continue;
+
+			parsed_policy = candidate;
+			return true;
+		}
+		return false;
+	}
+
+	const char* NumaMemory::getPolicyName(NumaPolicy name_policy)
+	{
+		switch (name_policy)
+		{
+		case NumaPolicy::OFF:
+			return "off";
+		case NumaPolicy::FIRST_TOUCH:
+			return "first-touch";
+		case NumaPolicy::INTERLEAVE:
+			return "interleave";
+		}
+		return "";
+	}
+
+	NumaPolicy NumaMemory::getPolicy() { return policy; }
+
+	void NumaMemory::setPolicy(NumaPolicy new_policy)
+	{
+		if (new_policy == NumaPolicy::INTERLEAVE && !isNumaLibraryAvailable())
+		{
+			printf("Interleaving needs libnuma, using first touch placement\n");
+			new_policy = NumaPolicy::FIRST_TOUCH;
+		}
+
+		// Cached arena blocks keep the placement of the policy they were first touched under.
+		if (new_policy != policy) HugePageArena::getInstance()->trim();
+		policy = new_policy;
+	}
+
+	bool NumaMemory::isThreadPinningEnabled() { return thread_pinning; }
+
+	bool NumaMemory::isNumaLibraryAvailable()
+	{
+#ifdef _WIN32
+		return false;
+#else
+		return numa_library.handle && numa_library.numa_interleave_memory && numa_library.numa_all_nodes_ptr;
+#endif
+	}
+
+	int NumaMemory::getNodeCount() { return node_count; }
+
+	// Orders the allowed CPUs node by node in turn: first CPU of node 0, first of node 1, second of node 0...
+	void NumaMemory::loadTopology()
+	{
+		std::vector<int> allowed_cpus;
+		std::vector<int> cpu_nodes;
+
+#ifdef _WIN32
+		ULONG highest_node = 0;
+		if (GetNumaHighestNodeNumber(&highest_node)) node_count = static_cast<int>(highest_node) + 1;
+
+		DWORD_PTR process_mask = 0;
+		DWORD_PTR system_mask = 0;
+		if (GetProcessAffinityMask(GetCurrentProcess(), &process_mask, &system_mask))
+		{
+			for (int cpu = 0; cpu < static_cast<int>(sizeof(DWORD_PTR) * 8); cpu++)
+			{
+				if (!(process_mask & (static_cast<DWORD_PTR>(1) << cpu))) continue;
+
+				UCHAR node = 0;
+				allowed_cpus.push_back(cpu);
+				cpu_nodes.push_back(GetNumaProcessorNode(static_cast<UCHAR>(cpu), &node) && node != 0xFF ? node : 0);
+			}
+		}
+#else
+		bool has_numa_library = numa_library.load();
+		if (has_numa_library) node_count = numa_library.numa_max_node() + 1;
+
+		cpu_set_t process_cpus;
+		CPU_ZERO(&process_cpus);
+		if (sched_getaffinity(0, sizeof(process_cpus), &process_cpus) == 0)
+		{
+			for (int cpu = 0; cpu < CPU_SETSIZE; cpu++)
+			{
+				if (!CPU_ISSET(cpu, &process_cpus)) continue;
+
+				allowed_cpus.push_back(cpu);
+				cpu_nodes.push_back(has_numa_library ? std::max(0, numa_library.numa_node_of_cpu(cpu)) : 0);
+			}
+		}
+#endif
+
+		node_count = std::max(1, node_count);
+		std::vector<std::vector<int>> cpus_by_node(node_count);
+		for (std::size_t i = 0; i < allowed_cpus.size(); i++) cpus_by_node[std::min(cpu_nodes[i], node_count - 1)].push_back(allowed_cpus[i]);
+
+		pinning_cpus.clear();
+		for (std::size_t rank = 0; pinning_cpus.size() < allowed_cpus.size(); rank++)
+		{
+			for (const std::vector<int>& node_cpus : cpus_by_node) if (rank < node_cpus.size()) pinning_cpus.push_back(node_cpus[rank]);
+		}
+	}
+
+	int NumaMemory::pinCurrentThread(int worker_index)
+	{
+		if (pinning_cpus.empty()) return -1;
+		int cpu = pinning_cpus[worker_index % pinning_cpus.size()];
+
+#ifdef _WIN32
+		if (!SetThreadAffinityMask(GetCurrentThread(), static_cast<DWORD_PTR>(1) << cpu)) return -1;
+#else
+		cpu_set_t cpu_set;
+		CPU_ZERO(&cpu_set);
+		CPU_SET(cpu, &cpu_set);
+		if (pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set) != 0) return -1;
+#endif
+		return cpu;
+	}
+
+	void* NumaMemory::allocate(std::size_t bytes)
+	{
+		bool fresh = false;
+		void* memory = HugePageArena::getInstance()->allocate(bytes, fresh);
+		if (!memory) return nullptr;
+
+#ifndef _WIN32
+		if (fresh && policy == NumaPolicy::INTERLEAVE) numa_library.numa_interleave_memory(memory, bytes, *numa_library.numa_all_nodes_ptr);
+#endif
+
+		if (policy == NumaPolicy::OFF) std::memset(memory, 0, bytes);
+		return memory;
+	}
+
+	void NumaMemory::deallocate(void* memory) { HugePageArena::getInstance()->release(memory); }
+
+	bool NumaMemory::countPagesPerNode(const void* memory, std::size_t bytes, std::vector<std::size_t>& pages_per_node)
+	{
+		std::size_t page_size = getPageSize();
+		std::size_t page_count = (bytes + page_size - 1) / page_size;
+		std::size_t sample_count = std::min(page_count, max_sampled_pages);
+		pages_per_node.assign(node_count, 0);
+		if (sample_count == 0) return true;
+
+		std::vector<void*> pages(sample_count);
+		for (std::size_t i = 0; i < sample_count; i++) pages[i] = const_cast<char*>(static_cast<const char*>(memory)) + i * page_count / sample_count * page_size;
+
+		std::vector<int> page_nodes(sample_count, -1);
+#ifdef _WIN32
+		std::vector<PSAPI_WORKING_SET_EX_INFORMATION> page_information(sample_count);
+		for (std::size_t i = 0; i < sample_count; i++) page_information[i].VirtualAddress = pages[i];
+		if (!QueryWorkingSetEx(GetCurrentProcess(), page_information.data(), static_cast<DWORD>(sample_count * sizeof(PSAPI_WORKING_SET_EX_INFORMATION)))) return false;
+
+		for (std::size_t i = 0; i < sample_count; i++) if (page_information[i].VirtualAttributes.Valid) page_nodes[i] = static_cast<int>(page_information[i].VirtualAttributes.Node);
+#else
+		if (!numa_library.numa_move_pages) return false;
+		if (numa_library.numa_move_pages(0, static_cast<unsigned long>(sample_count), pages.data(), nullptr, page_nodes.data(), 0) != 0) return false;
+#endif
+
+		// Scale the sample back up to the whole range; pages not resident yet report a negative node.
+		for (std::size_t i = 0; i < sample_count; i++)
+		{
+			if (page_nodes[i] >= 0 && page_nodes[i] < node_count) pages_per_node[page_nodes[i]] += page_count / sample_count;
+		}
+		return true;
+	}
+}
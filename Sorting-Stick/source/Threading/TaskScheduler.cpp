@@ -0,0 +1,223 @@
+#include "Threading/TaskScheduler.h"
+#include "Threading/NumaMemory.h"
+#include <algorithm>
+
+namespace Threading
+{
+	thread_local int TaskScheduler::current_worker_index = -1;
+	thread_local const TaskScheduler* TaskScheduler::current_scheduler = nullptr;
+
+	TaskScheduler::TaskScheduler()
+	{
+		stopping = false;
+		queued_tasks = 0;
+		next_submit_worker = 0;
+		stats_busy_nanoseconds = 0;
+	}
+
+	TaskScheduler::~TaskScheduler() { destroy(); }
+
+	TaskScheduler* TaskScheduler::getInstance()
+	{
+		static TaskScheduler instance;
+		return &instance;
+	}
+
+	void TaskScheduler::initialize(int thread_count)
+	{
+		std::call_once(start_flag, &TaskScheduler::start, this, thread_count);
+	}
+
+	void TaskScheduler::start(int thread_count)
+	{
+		if (thread_count <= 0) thread_count = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+
+		for (int i = 0; i < thread_count; i++) workers.push_back(std::make_unique<Worker>());
+		for (int i = 0; i < thread_count; i++) workers[i]->thread = std::thread(&TaskScheduler::runWorker, this, i);
+
+		stats_time = std::chrono::steady_clock::now();
+	}
+
+	void TaskScheduler::destroy()
+	{
+		{
+			std::lock_guard<std::mutex> lock(sleep_mutex);
+			stopping = true;
+		}
+		wake_condition.notify_all();
+
+		for (std::unique_ptr<Worker>& worker : workers) if (worker->thread.joinable()) worker->thread.join();
+	}
+
+	int TaskScheduler::getThreadCount()
+	{
+		initialize(0);
+		return static_cast<int>(workers.size());
+	}
+
+	TaskSchedulerStats TaskScheduler::getStats()
+	{
+		initialize(0);
+
+		TaskSchedulerStats stats = { static_cast<int>(workers.size()), 0, 0, 0.f };
+		std::uint64_t busy_nanoseconds = 0;
+		for (std::unique_ptr<Worker>& worker : workers)
+		{
+			stats.tasks_executed += worker->tasks_executed;
+			stats.tasks_stolen += worker->tasks_stolen;
+			busy_nanoseconds += worker->busy_nanoseconds;
+		}
+
+		std::lock_guard<std::mutex> lock(stats_mutex);
+		std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+		double elapsed_nanoseconds = std::chrono::duration<double, std::nano>(now - stats_time).count() * workers.size();
+		if (elapsed_nanoseconds > 0) stats.utilization = static_cast<float>(std::min(1.0, (busy_nanoseconds - stats_busy_nanoseconds) / elapsed_nanoseconds));
+
+		stats_time = now;
+		stats_busy_nanoseconds = busy_nanoseconds;
+		return stats;
+	}
+
+	void TaskScheduler::submit(std::function<void()> task)
+	{
+		initialize(0);
+
+		// Forked tasks go to the forking worker's own deque; everything else is dealt round robin.
+		int worker_index = current_scheduler == this ? current_worker_index : static_cast<int>(next_submit_worker++ % workers.size());
+		{
+			std::lock_guard<std::mutex> lock(workers[worker_index]->deque_mutex);
+			workers[worker_index]->tasks.push_back(std::move(task));
+		}
+		queued_tasks++;
+
+		// Taking the sleep mutex orders this against a worker that has just found nothing to do.
+		{ std::lock_guard<std::mutex> lock(sleep_mutex); }
+		wake_condition.notify_one();
+	}
+
+	bool TaskScheduler::runPendingTask()
+	{
+		initialize(0);
+
+		int worker_index = current_scheduler == this ? current_worker_index : -1;
+		std::function<void()> task;
+
+		if ((worker_index >= 0 && popTask(worker_index, task)) || stealTask(worker_index, task))
+		{
+			executeTask(worker_index, task);
+			return true;
+		}
+		return false;
+	}
+
+	void TaskScheduler::parallelFor(std::size_t first, std::size_t last, std::size_t min_chunk_size, const std::function<void(std::size_t, std::size_t)>& body)
+	{
+		if (first >= last) return;
+
+		// A few chunks per worker so a worker that finishes early can steal the remainder.
+		std::size_t count = last - first;
+		std::size_t chunk_count = std::max<std::size_t>(1, std::min<std::size_t>(getThreadCount() * 4, count / std::max<std::size_t>(min_chunk_size, 1)));
+		std::size_t chunk_size = (count + chunk_count - 1) / chunk_count;
+
+		TaskGroup chunk_group;
+		for (std::size_t chunk_first = first + chunk_size; chunk_first < last; chunk_first += chunk_size)
+		{
+			std::size_t chunk_last = std::min(last, chunk_first + chunk_size);
+			chunk_group.run([&body, chunk_first, chunk_last]() { body(chunk_first, chunk_last); });
+		}
+
+		body(first, std::min(last, first + chunk_size));
+		chunk_group.wait();
+	}
+
+	void TaskScheduler::runWorker(int worker_index)
+	{
+		current_worker_index = worker_index;
+		current_scheduler = this;
+		if (NumaMemory::isThreadPinningEnabled()) NumaMemory::pinCurrentThread(worker_index);
+
+		std::function<void()> task;
+		while (!stopping)
+		{
+			if (popTask(worker_index, task) || stealTask(worker_index, task))
+			{
+				executeTask(worker_index, task);
+				continue;
+			}
+
+			std::unique_lock<std::mutex> lock(sleep_mutex);
+			wake_condition.wait(lock, [this]() { return stopping || queued_tasks > 0; });
+		}
+	}
+
+	bool TaskScheduler::popTask(int worker_index, std::function<void()>& task)
+	{
+		Worker& worker = *workers[worker_index];
+		std::lock_guard<std::mutex> lock(worker.deque_mutex);
+		if (worker.tasks.empty()) return false;
+
+		task = std::move(worker.tasks.back());
+		worker.tasks.pop_back();
+		queued_tasks--;
+		return true;
+	}
+
+	// thief_index is -1 for threads outside the pool; victims are tried starting after the thief.
+	bool TaskScheduler::stealTask(int thief_index, std::function<void()>& task)
+	{
+		int worker_count = static_cast<int>(workers.size());
+		for (int offset = 1; offset <= worker_count; offset++)
+		{
+			int victim_index = (thief_index + offset + worker_count) % worker_count;
+			if (victim_index == thief_index) continue;
+
+			Worker& victim = *workers[victim_index];
+			std::lock_guard<std::mutex> lock(victim.deque_mutex);
+			if (victim.tasks.empty()) continue;
+
+			task = std::move(victim.tasks.front());
+			victim.tasks.pop_front();
+			queued_tasks--;
+			if (thief_index >= 0) workers[thief_index]->tasks_stolen++;
+			return true;
+		}
+		return false;
+	}
+
+	void TaskScheduler::executeTask(int worker_index, std::function<void()>& task)
+	{
+		std::chrono::steady_clock::time_point start_time = std::chrono::steady_clock::now();
+		task();
+		task = nullptr;
+
+		if (worker_index < 0) return;
+		workers[worker_index]->busy_nanoseconds += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start_time).count();
+		workers[worker_index]->tasks_executed++;
+	}
+
+	TaskGroup::TaskGroup()
+	{
+		scheduler = TaskScheduler::getInstance();
+		pending_tasks = 0;
+	}
+
+	TaskGroup::~TaskGroup() { wait(); }
+
+	void TaskGroup::run(std::function<void()> task)
+	{
+		pending_tasks++;
+		scheduler->submit([this, task = std::move(task)]()
+			{
+				task();
+				pending_tasks--;
+			});
+	}
+
+	void TaskGroup::wait()
+	{
+		while (pending_tasks > 0)
+		{
+			if (!scheduler->runPendingTask()) std::this_thread::yield();
+		}
+	}
+}
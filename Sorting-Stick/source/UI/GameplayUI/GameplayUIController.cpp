@@ -5,6 +5,8 @@
 #include "Sound/SoundService.h"
 #include "Main/GameService.h"
 #include "Gameplay/Collection/StickCollectionModel.h"
+#include <charconv>
+#include <cstring>
 
 namespace UI
 {
@@ -19,6 +21,8 @@ namespace UI
 
         GameplayUIController::GameplayUIController()
         {
+            has_displayed_values = false;
+            displayed_race_mode = false;
             createButton();
             createTexts();
         }
@@ -48,6 +52,7 @@ namespace UI
             num_sticks_text = new TextView();
             delay_text = new TextView();
             time_complexity_text = new TextView();
+            stability_text = new TextView();
         }
 
         void GameplayUIController::initializeButton()
@@ -73,18 +78,40 @@ namespace UI
 
 
             time_complexity_text->initialize("Time Complexity  :  O(n)", sf::Vector2f(time_complexity_text_x_position, text_y_pos2), FontType::BUBBLE_BOBBLE, font_size);
+
+            stability_text->initialize("Stable  :  Yes", sf::Vector2f(stability_text_x_position, text_y_pos3), FontType::BUBBLE_BOBBLE, font_size);
         }
 
         void GameplayUIController::update()
         {
             menu_button->update();
+
+            // Race mode reuses the top row for the race summary; switching modes rebuilds every text.
+            bool race_mode = ServiceLocator::getInstance()->getGameplayService()->isRaceMode();
+            if (race_mode != displayed_race_mode) has_displayed_values = false;
+            displayed_race_mode = race_mode;
+
+            if (race_mode)
+            {
+                if (shouldRefreshCounters()) updateRaceTexts();
+                has_displayed_values = true;
+                return;
+            }
+
             updateSearchTypeText();
-            updateComparisonsText();
-            updateArrayAccessText();
+
+            if (shouldRefreshCounters())
+            {
+                updateComparisonsText();
+                updateArrayAccessText();
+            }
 
             updateNumberOfSticksText();
             updateDelayText();
             updateTimeComplexityText();
+            updateStabilityText();
+
+            has_displayed_values = true;
         }
 
         void GameplayUIController::render()
@@ -93,10 +120,12 @@ namespace UI
             search_type_text->render();
             comparisons_text->render();
             array_access_text->render();
+            if (displayed_race_mode) return;
 
             num_sticks_text->render();
             delay_text->render();
             time_complexity_text->render();
+            stability_text->render();
         }
 
         void GameplayUIController::show()
@@ -109,86 +138,127 @@ namespace UI
             num_sticks_text->show();
             delay_text->show();
             time_complexity_text->show();
+            stability_text->show();
+
+            // Force every text to be rebuilt for the new run.
+            has_displayed_values = false;
+            counter_refresh_clock.restart();
         }
 
-        void GameplayUIController::updateSearchTypeText()
+        bool GameplayUIController::shouldRefreshCounters()
         {
-            SortType sort_type = ServiceLocator::getInstance()->getGameplayService()->getSortType();
+            if (!has_displayed_values) return true;
+            if (counter_refresh_clock.getElapsedTime().asSeconds() < 1.f / counter_refresh_rate) return false;
 
-            switch (sort_type)
-            {
-            case::Gameplay::SortType::BUBBLE_SORT:
-                search_type_text->setText("Bubble Sort");
-                break;
+            counter_refresh_clock.restart();
+            return true;
+        }
 
-            case::Gameplay::SortType::INSERTION_SORT:
-                search_type_text->setText("Insertion Sort");
-                break;
+        const char* GameplayUIController::formatCounterText(const char* label, long long value)
+        {
+            std::size_t label_length = std::strlen(label);
+            std::memcpy(text_buffer, label, label_length);
 
-            case::Gameplay::SortType::SELECTION_SORT:
-                search_type_text->setText("Selection Sort");
-                break;
+            std::to_chars_result result = std::to_chars(text_buffer + label_length, text_buffer + text_buffer_size - 1, value);
+            *result.ptr = '\0';
 
-            case::Gameplay::SortType::MERGE_SORT:
-                search_type_text->setText("Merge Sort");
-                break;
+            return text_buffer;
+        }
 
-            case::Gameplay::SortType::QUICK_SORT:
-                search_type_text->setText("Quick Sort");
-                break;
+        void GameplayUIController::updateSearchTypeText()
+        {
+            SortType sort_type = ServiceLocator::getInstance()->getGameplayService()->getSortType();
+            if (has_displayed_values && sort_type == displayed_sort_type) return;
+            displayed_sort_type = sort_type;
 
-            case::Gameplay::SortType::RADIX_SORT:
-                search_type_text->setText("Radix Sort");
-                break;
-            }
+            search_type_text->setText(getSortTypeName(sort_type));
+            search_type_text->update();
+        }
+
+        void GameplayUIController::updateRaceTexts()
+        {
+            GameplayService* gameplay_service = ServiceLocator::getInstance()->getGameplayService();
+            const std::vector<SortType>& finish_order = gameplay_service->getRaceFinishOrder();
+            int lane_count = gameplay_service->getRaceLaneCount();
+
+            search_type_text->setText(formatCounterText("Race  :  Lanes  ", lane_count));
             search_type_text->update();
+
+            comparisons_text->setText(formatCounterText("Finished  :  ", static_cast<int>(finish_order.size())));
+            comparisons_text->update();
+
+            array_access_text->setText(sf::String("Winner  :  ") + (finish_order.empty() ? "-" : getSortTypeName(finish_order.front())));
+            array_access_text->update();
         }
 
         void GameplayUIController::updateComparisonsText()
         {
-            int comparisons = ServiceLocator::getInstance()->getGameplayService()->getNumberOfComparisons();;
-            sf::String comparisons_string = "Comparisons  :  " + std::to_string(comparisons);
+            long long comparisons = ServiceLocator::getInstance()->getGameplayService()->getNumberOfComparisons();
+            if (has_displayed_values && comparisons == displayed_comparisons) return;
+            displayed_comparisons = comparisons;
 
-            comparisons_text->setText(comparisons_string);
+            comparisons_text->setText(formatCounterText("Comparisons  :  ", comparisons));
             comparisons_text->update();
         }
 
         void GameplayUIController::updateArrayAccessText()
         {
-            int array_access = ServiceLocator::getInstance()->getGameplayService()->getNumberOfArrayAccess();;
-            sf::String array_access_string = "Array Access  :  " + std::to_string(array_access);
+            long long array_access = ServiceLocator::getInstance()->getGameplayService()->getNumberOfArrayAccess();
+            if (has_displayed_values && array_access == displayed_array_access) return;
+            displayed_array_access = array_access;
 
-            array_access_text->setText(array_access_string);
+            array_access_text->setText(formatCounterText("Array Access  :  ", array_access));
             array_access_text->update();
         }
 
         void GameplayUIController::updateNumberOfSticksText()
         {
             int num_sticks = ServiceLocator::getInstance()->getGameplayService()->getNumberOfSticks();
-            sf::String sticks_string = "Number of Sticks  :  " + std::to_string(num_sticks);
+            if (has_displayed_values && num_sticks == displayed_num_sticks) return;
+            displayed_num_sticks = num_sticks;
 
-            num_sticks_text->setText(sticks_string);
+            num_sticks_text->setText(formatCounterText("Number of Sticks  :  ", num_sticks));
             num_sticks_text->update();
         }
 
         void GameplayUIController::updateDelayText()
         {
             int delay_in_milliseconds = ServiceLocator::getInstance()->getGameplayService()->getDelayMilliseconds();
-            sf::String delay_string = "Delay (ms)  :  " + std::to_string(delay_in_milliseconds);
+            if (has_displayed_values && delay_in_milliseconds == displayed_delay) return;
+            displayed_delay = delay_in_milliseconds;
 
-            delay_text->setText(delay_string);
+            delay_text->setText(formatCounterText("Delay (ms)  :  ", delay_in_milliseconds));
             delay_text->update();
         }
 
         void GameplayUIController::updateTimeComplexityText()
         {
-            sf::String time_complexity = ServiceLocator::getInstance()->getGameplayService()->getTimeComplexity();
-            sf::String time_complexity_string = "Time Complexity  :  " + time_complexity;
+            const sf::String& time_complexity = ServiceLocator::getInstance()->getGameplayService()->getTimeComplexity();
+            if (has_displayed_values && time_complexity == displayed_time_complexity) return;
+            displayed_time_complexity = time_complexity;
 
-            time_complexity_text->setText(time_complexity_string);
+            time_complexity_text->setText("Time Complexity  :  " + time_complexity);
             time_complexity_text->update();
         }
 
+        // Whether the selected sort guarantees stability, and once it finished whether the result kept
+        // equal keys in their input order.
+        void GameplayUIController::updateStabilityText()
+        {
+            GameplayService* gameplay_service = ServiceLocator::getInstance()->getGameplayService();
+            bool stable_sort = gameplay_service->isStableSort();
+            Sorting::StabilityCheck stability_check = gameplay_service->getStabilityCheck();
+            if (has_displayed_values && stable_sort == displayed_stable_sort && stability_check == displayed_stability_check) return;
+            displayed_stable_sort = stable_sort;
+            displayed_stability_check = stability_check;
+
+            sf::String text = stable_sort ? "Stable  :  Yes" : "Stable  :  No";
+            if (stability_check != Sorting::StabilityCheck::NOT_CHECKED) text += sf::String("     Result  :  ") + Sorting::getStabilityCheckName(stability_check);
+
+            stability_text->setText(text);
+            stability_text->update();
+        }
+
         void GameplayUIController::menuButtonCallback()
         {
             ServiceLocator::getInstance()->getSoundService()->playSound(SoundType::BUTTON_CLICK);
@@ -210,6 +280,7 @@ namespace UI
             delete (num_sticks_text);
             delete(delay_text);
             delete(time_complexity_text);
+            delete(stability_text);
         }
     }
 }
\ No newline at end of file
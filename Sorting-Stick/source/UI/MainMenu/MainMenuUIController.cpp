@@ -5,6 +5,9 @@
 #include "Event/EventService.h"
 #include "Global/Config.h"
 #include "Global/ServiceLocator.h"
+#include "Gameplay/Collection/StickCollectionModel.h"
+#include <cmath>
+#include <cstdio>
 
 
 namespace UI
@@ -21,6 +24,7 @@ namespace UI
         {
             createImage();
             createButtons();
+            createText();
         }
 
         MainMenuUIController::~MainMenuUIController()
@@ -32,6 +36,8 @@ namespace UI
         {
             initializeBackgroundImage();
             initializeButtons();
+            initializeText();
+            initializeSlider();
             registerButtonCallback();
         }
 
@@ -49,6 +55,21 @@ namespace UI
             quick_sort_button = new ButtonView();
             radix_sort_button = new ButtonView();
             quit_button = new ButtonView();
+            race_button = new ButtonView();
+
+            center_column_sort_types = { Gameplay::Collection::SortType::EXTERNAL_MERGE_SORT, Gameplay::Collection::SortType::MULTIWAY_MERGE_SORT,
+                Gameplay::Collection::SortType::PARTIAL_SORT, Gameplay::Collection::SortType::NTH_ELEMENT, Gameplay::Collection::SortType::TOP_K,
+                Gameplay::Collection::SortType::AMERICAN_FLAG_SORT };
+            for (int i = 0; i < center_column_sort_types.size(); i++) center_column_buttons.push_back(new ButtonView());
+        }
+
+        void MainMenuUIController::createText()
+        {
+            race_label = new TextView();
+            for (int i = 0; i < center_column_sort_types.size(); i++) center_column_labels.push_back(new TextView());
+            sticks_label = new TextView();
+            sticks_slider = new SliderView();
+            displayed_number_of_sticks = 0;
         }
 
         void MainMenuUIController::initializeBackgroundImage()
@@ -67,9 +88,47 @@ namespace UI
             merge_sort_button->initialize("Merge Sort Button", Config::merge_sort_button_texture_path, button_width, button_height, sf::Vector2f(second_column_button_x_position, merge_sort_button_y_position));
             quick_sort_button->initialize("Quick Sort Button", Config::quick_sort_button_texture_path, button_width, button_height, sf::Vector2f(second_column_button_x_position, quick_sort_button_y_position));
             radix_sort_button->initialize("Radix Sort Button", Config::radix_sort_button_texture_path, button_width, button_height, sf::Vector2f(second_column_button_x_position, radix_sort_button_y_position));
-            quit_button->initialize("Quit Button", Config::quit_button_texture_path, button_width, button_height, sf::Vector2f(0, quit_button_y_position));
+            quit_button->initialize("Quit Button", Config::quit_button_texture_path, button_width, button_height, sf::Vector2f(second_column_button_x_position, quit_button_y_position));
+            race_button->initialize("Race Button", Config::play_button_texture_path, button_width, button_height, sf::Vector2f(first_column_button_x_position, race_button_y_position));
+
+            for (int i = 0; i < center_column_buttons.size(); i++)
+            {
+                sf::Vector2f position(center_column_button_x_position, center_column_button_y_positions[i]);
+                center_column_buttons[i]->initialize(Gameplay::Collection::getSortTypeName(center_column_sort_types[i]), Config::play_button_texture_path, center_column_button_width, center_column_button_height, position);
+            }
+        }
+
+        void MainMenuUIController::initializeText()
+        {
+            race_label->initialize("Race Sorts", sf::Vector2f(first_column_button_x_position, race_button_y_position + race_label_y_offset), FontType::BUBBLE_BOBBLE, race_label_font_size);
+
+            for (int i = 0; i < center_column_labels.size(); i++)
+            {
+                sf::Vector2f position(center_column_button_x_position, center_column_button_y_positions[i] + race_label_y_offset);
+                center_column_labels[i]->initialize(Gameplay::Collection::getSortTypeName(center_column_sort_types[i]), position, FontType::BUBBLE_BOBBLE, race_label_font_size);
+            }
+            sticks_label->initialize("", sf::Vector2f(sticks_label_x_position, sticks_label_y_position), FontType::BUBBLE_BOBBLE, sticks_label_font_size);
+        }
+
+        void MainMenuUIController::initializeSlider()
+        {
+            Gameplay::Collection::StickCollectionModel collection_model;
+            int number_of_sticks = ServiceLocator::getInstance()->getGameplayService()->getNumberOfSticks();
+
+            sticks_slider->initialize(sf::Vector2f(sticks_slider_x_position, sticks_slider_y_position), sticks_slider_width, sticks_slider_height,
+                static_cast<float>(collection_model.min_number_of_elements), static_cast<float>(collection_model.max_number_of_elements), static_cast<float>(number_of_sticks), true);
+            updateSticksLabel(number_of_sticks);
+        }
+
+        void MainMenuUIController::updateSticksLabel(int number_of_sticks)
+        {
+            if (number_of_sticks == displayed_number_of_sticks) return;
+            displayed_number_of_sticks = number_of_sticks;
 
-            quit_button->setCentreAlinged();
+            char label[64];
+            snprintf(label, sizeof(label), "Sticks  :  %d", number_of_sticks);
+            sticks_label->setText(label);
+            sticks_label->update();
         }
 
         void MainMenuUIController::registerButtonCallback()
@@ -81,6 +140,10 @@ namespace UI
             quick_sort_button->registerCallbackFuntion(std::bind(&MainMenuUIController::quickSortButtonCallback, this));
             radix_sort_button->registerCallbackFuntion(std::bind(&MainMenuUIController::radixSortButtonCallback, this));
             quit_button->registerCallbackFuntion(std::bind(&MainMenuUIController::quitButtonCallback, this));
+            race_button->registerCallbackFuntion(std::bind(&MainMenuUIController::raceButtonCallback, this));
+            for (int i = 0; i < center_column_buttons.size(); i++)
+                center_column_buttons[i]->registerCallbackFuntion(std::bind(&MainMenuUIController::centerColumnButtonCallback, this, center_column_sort_types[i]));
+            sticks_slider->registerCallbackFuntion(std::bind(&MainMenuUIController::sticksSliderCallback, this, std::placeholders::_1));
         }
 
         void MainMenuUIController::bubbleSortButtonCallback()
@@ -125,6 +188,27 @@ namespace UI
             ServiceLocator::getInstance()->getGameplayService()->sortElement(Gameplay::Collection::SortType::RADIX_SORT);
         }
 
+        void MainMenuUIController::raceButtonCallback()
+        {
+            ServiceLocator::getInstance()->getSoundService()->playSound(SoundType::BUTTON_CLICK);
+            GameService::setGameState(GameState::GAMEPLAY);
+            Gameplay::GameplayService* gameplay_service = ServiceLocator::getInstance()->getGameplayService();
+            gameplay_service->startRace(gameplay_service->getRaceSortTypes());
+        }
+
+        void MainMenuUIController::centerColumnButtonCallback(Gameplay::Collection::SortType sort_type)
+        {
+            ServiceLocator::getInstance()->getSoundService()->playSound(SoundType::BUTTON_CLICK);
+            GameService::setGameState(GameState::GAMEPLAY);
+            ServiceLocator::getInstance()->getGameplayService()->sortElement(sort_type);
+        }
+
+        // The collection is only rebuilt once the drag ends, not for every intermediate value.
+        void MainMenuUIController::sticksSliderCallback(float value)
+        {
+            ServiceLocator::getInstance()->getGameplayService()->setNumberOfSticks(static_cast<int>(std::lround(value)));
+        }
+
         void MainMenuUIController::quitButtonCallback()
         {
             ServiceLocator::getInstance()->getGraphicService()->getGameWindow()->close();
@@ -140,6 +224,19 @@ namespace UI
             quick_sort_button->update();
             radix_sort_button->update();
             quit_button->update();
+            race_button->update();
+            race_label->update();
+            for (ButtonView* button : center_column_buttons) button->update();
+            for (TextView* label : center_column_labels) label->update();
+            sticks_slider->update();
+
+            if (sticks_slider->isDragging()) updateSticksLabel(static_cast<int>(std::lround(sticks_slider->getValue())));
+            else
+            {
+                int number_of_sticks = ServiceLocator::getInstance()->getGameplayService()->getNumberOfSticks();
+                if (number_of_sticks != displayed_number_of_sticks) sticks_slider->setValue(static_cast<float>(number_of_sticks));
+                updateSticksLabel(number_of_sticks);
+            }
         }
 
         void MainMenuUIController::render()
@@ -152,6 +249,12 @@ namespace UI
             quick_sort_button->render();
             radix_sort_button->render();
             quit_button->render();
+            race_button->render();
+            race_label->render();
+            for (ButtonView* button : center_column_buttons) button->render();
+            for (TextView* label : center_column_labels) label->render();
+            sticks_label->render();
+            sticks_slider->render();
         }
 
         void MainMenuUIController::show()
@@ -164,6 +267,12 @@ namespace UI
             quick_sort_button->show();
             radix_sort_button->show();
             quit_button->show();
+            race_button->show();
+            race_label->show();
+            for (ButtonView* button : center_column_buttons) button->show();
+            for (TextView* label : center_column_labels) label->show();
+            sticks_label->show();
+            sticks_slider->show();
         }
 
         void MainMenuUIController::destroy()
@@ -175,6 +284,12 @@ namespace UI
             delete (quick_sort_button);
             delete (radix_sort_button);
             delete (quit_button);
+            delete (race_button);
+            delete (race_label);
+            for (ButtonView* button : center_column_buttons) delete (button);
+            for (TextView* label : center_column_labels) delete (label);
+            delete (sticks_label);
+            delete (sticks_slider);
             delete (background_image);
         }
     }
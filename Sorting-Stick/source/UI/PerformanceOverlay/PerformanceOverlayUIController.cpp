@@ -0,0 +1,173 @@
+#include "UI/PerformanceOverlay/PerformanceOverlayUIController.h"
+#include "Global/ServiceLocator.h"
+#include "Event/EventService.h"
+#include "Profiling/ProfilingService.h"
+#include "Gameplay/GameplayService.h"
+#include "Threading/TaskScheduler.h"
+#include <cstdio>
+
+namespace UI
+{
+	namespace PerformanceOverlay
+	{
+		using namespace Global;
+		using namespace UIElement;
+		using namespace Profiling;
+
+		PerformanceOverlayUIController::PerformanceOverlayUIController()
+		{
+			overlay_visible = false;
+			last_sort_operation_count = 0;
+			createElements();
+		}
+
+		PerformanceOverlayUIController::~PerformanceOverlayUIController()
+		{
+			destroy();
+		}
+
+		void PerformanceOverlayUIController::createElements()
+		{
+			background_panel = new RectangleShapeView();
+			frame_time_text = new TextView();
+			update_render_text = new TextView();
+			draw_calls_text = new TextView();
+			sort_throughput_text = new TextView();
+			memory_text = new TextView();
+			worker_text = new TextView();
+			histogram_title_text = new TextView();
+
+			for (int i = 0; i < histogram_bucket_count; i++) histogram_bars[i] = new RectangleShapeView();
+		}
+
+		void PerformanceOverlayUIController::initialize()
+		{
+			initializeElements();
+		}
+
+		void PerformanceOverlayUIController::initializeElements()
+		{
+			background_panel->initialize(sf::Vector2f(panel_width, panel_height), sf::Vector2f(panel_x_position, panel_y_position), 0, panel_color);
+
+			TextView* texts[] = { frame_time_text, update_render_text, draw_calls_text, sort_throughput_text, memory_text, worker_text, histogram_title_text };
+			for (int i = 0; i < 7; i++)
+			{
+				sf::Vector2f position(text_x_position, first_text_y_position + i * text_line_spacing);
+				texts[i]->initialize("", position, FontType::DS_DIGIB, font_size);
+			}
+			histogram_title_text->setText("Frame Time Histogram (4 ms buckets)");
+
+			for (int i = 0; i < histogram_bucket_count; i++)
+			{
+				float x_position = histogram_x_position + i * (histogram_bar_width + histogram_bar_spacing);
+				histogram_bars[i]->initialize(sf::Vector2f(histogram_bar_width, 0.f), sf::Vector2f(x_position, histogram_base_y_position), 0, histogram_bar_color);
+			}
+		}
+
+		void PerformanceOverlayUIController::update()
+		{
+			handleToggleInput();
+			if (!overlay_visible) return;
+
+			if (sample_clock.getElapsedTime().asSeconds() >= sample_interval_seconds) sampleStatistics();
+		}
+
+		void PerformanceOverlayUIController::render()
+		{
+			if (!overlay_visible) return;
+
+			background_panel->render();
+			frame_time_text->render();
+			update_render_text->render();
+			draw_calls_text->render();
+			sort_throughput_text->render();
+			memory_text->render();
+			worker_text->render();
+			histogram_title_text->render();
+
+			for (int i = 0; i < histogram_bucket_count; i++) histogram_bars[i]->render();
+		}
+
+		void PerformanceOverlayUIController::show()
+		{
+			overlay_visible = true;
+			sampleStatistics();
+		}
+
+		void PerformanceOverlayUIController::handleToggleInput()
+		{
+			if (!ServiceLocator::getInstance()->getEventService()->pressedF3Key()) return;
+
+			if (overlay_visible) overlay_visible = false;
+			else show();
+		}
+
+		void PerformanceOverlayUIController::sampleStatistics()
+		{
+			ProfilingService* profiling_service = ServiceLocator::getInstance()->getProfilingService();
+			Gameplay::GameplayService* gameplay_service = ServiceLocator::getInstance()->getGameplayService();
+
+			float elapsed_seconds = sample_clock.restart().asSeconds();
+			long long sort_operation_count = gameplay_service->getNumberOfComparisons() + gameplay_service->getNumberOfArrayAccess();
+			long long operations_delta = sort_operation_count - last_sort_operation_count;
+			last_sort_operation_count = sort_operation_count;
+			if (operations_delta < 0) operations_delta = 0; // counters were reset
+
+			char buffer[96];
+			float frame_time = profiling_service->getFrameTimeMilliseconds();
+
+			std::snprintf(buffer, sizeof(buffer), "Frame  :  %.2f ms  (%.0f fps)", frame_time, frame_time > 0.f ? 1000.f / frame_time : 0.f);
+			frame_time_text->setText(buffer);
+
+			std::snprintf(buffer, sizeof(buffer), "Update  :  %.2f ms   Render  :  %.2f ms", profiling_service->getUpdateTimeMilliseconds(), profiling_service->getRenderTimeMilliseconds());
+			update_render_text->setText(buffer);
+
+			std::snprintf(buffer, sizeof(buffer), "Draw Calls  :  %d", profiling_service->getDrawCallCount());
+			draw_calls_text->setText(buffer);
+
+			std::snprintf(buffer, sizeof(buffer), "Sort Ops/s  :  %.0f", elapsed_seconds > 0.f ? operations_delta / elapsed_seconds : 0.f);
+			sort_throughput_text->setText(buffer);
+
+			std::snprintf(buffer, sizeof(buffer), "Memory  :  %.1f MB", profiling_service->getProcessMemoryBytes() / (1024.0 * 1024.0));
+			memory_text->setText(buffer);
+
+			Threading::TaskSchedulerStats worker_stats = ServiceLocator::getInstance()->getTaskScheduler()->getStats();
+			std::snprintf(buffer, sizeof(buffer), "Workers  :  %d   Busy  :  %.0f%%   Stolen  :  %llu", worker_stats.thread_count, worker_stats.utilization * 100.f, static_cast<unsigned long long>(worker_stats.tasks_stolen));
+			worker_text->setText(buffer);
+
+			updateHistogramBars();
+		}
+
+		void PerformanceOverlayUIController::updateHistogramBars()
+		{
+			int bucket_counts[histogram_bucket_count];
+			ServiceLocator::getInstance()->getProfilingService()->getFrameTimeHistogram(bucket_counts, histogram_bucket_count, histogram_bucket_width_ms);
+
+			int max_count = 1;
+			for (int i = 0; i < histogram_bucket_count; i++) if (bucket_counts[i] > max_count) max_count = bucket_counts[i];
+
+			for (int i = 0; i < histogram_bucket_count; i++)
+			{
+				float bar_height = histogram_max_bar_height * bucket_counts[i] / max_count;
+				float x_position = histogram_x_position + i * (histogram_bar_width + histogram_bar_spacing);
+
+				histogram_bars[i]->setSize(sf::Vector2f(histogram_bar_width, bar_height));
+				histogram_bars[i]->setPosition(sf::Vector2f(x_position, histogram_base_y_position - bar_height));
+			}
+		}
+
+		void PerformanceOverlayUIController::destroy()
+		{
+			delete (background_panel);
+			delete (frame_time_text);
+			delete (update_render_text);
+			delete (draw_calls_text);
+			delete (sort_throughput_text);
+			delete (memory_text);
+			delete (worker_text);
+			delete (histogram_title_text);
+
+			for (int i = 0; i < histogram_bucket_count; i++) delete (histogram_bars[i]);
+		}
+	}
+}
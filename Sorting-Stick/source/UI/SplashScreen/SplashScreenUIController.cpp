@@ -51,9 +51,12 @@ namespace UI
             outscal_logo_view->playAnimation(AnimationType::FADE_OUT, logo_animation_duration, std::bind(&SplashScreenUIController::fadeOutAnimationCallback, this));
         }
 
+        // Invoked every frame once the fade out has finished, so the splash simply holds
+        // on its last frame until the background asset loading is done.
         void SplashScreenUIController::fadeOutAnimationCallback()
         {
-            
+            if (!ServiceLocator::getInstance()->areAssetsReady()) return;
+
             GameService::setGameState(GameState::MAIN_MENU);
         }
 
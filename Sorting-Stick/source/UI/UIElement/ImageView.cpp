@@ -1,5 +1,6 @@
 #include "UI/UIElement/ImageView.h"
 #include "Global/ServiceLocator.h"
+#include "Resource/ResourceService.h"
 #include <iostream>
 
 namespace UI
@@ -31,15 +32,17 @@ namespace UI
 
             if (ui_state == UIState::VISIBLE)
             {
-                game_window->draw(image_sprite);
+                draw(image_sprite);
             }
         }
 
         void ImageView::setTexture(sf::String texture_path)
         {
-            if (image_texture.loadFromFile(texture_path))
+            sf::Texture* texture = ServiceLocator::getInstance()->getResourceService()->getTexture(texture_path);
+
+            if (texture)
             {
-                image_sprite.setTexture(image_texture);
+                image_sprite.setTexture(*texture);
             }
         }
 
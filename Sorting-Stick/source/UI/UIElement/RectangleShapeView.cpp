@@ -30,7 +30,7 @@ namespace UI
 
 			if (ui_state == UIState::VISIBLE)
 			{
-				game_window->draw(rectangle_shape);
+				draw(rectangle_shape);
 			}
 		}
 
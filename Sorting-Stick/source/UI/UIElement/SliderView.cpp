@@ -0,0 +1,132 @@
+#include "UI/UIElement/SliderView.h"
+#include "Global/ServiceLocator.h"
+#include "Event/EventService.h"
+#include <algorithm>
+#include <cmath>
+
+namespace UI
+{
+	namespace UIElement
+	{
+		using namespace Global;
+
+		SliderView::SliderView()
+		{
+			min_value = 0.f;
+			max_value = 1.f;
+			value = 0.f;
+			logarithmic = false;
+			dragging = false;
+		}
+
+		SliderView::~SliderView() = default;
+
+		void SliderView::initialize(sf::Vector2f position, float slider_width, float slider_height, float min_value, float max_value, float initial_value, bool logarithmic)
+		{
+			UIView::initialize();
+
+			this->min_value = min_value;
+			this->max_value = max_value;
+			this->logarithmic = logarithmic;
+
+			sf::Vector2f track_size = getScaleForCurrentResolution(slider_width, slider_height);
+			float knob_radius = track_size.y * knob_radius_ratio;
+
+			track_shape.setPosition(getPositionForCurrentResolution(position));
+			track_shape.setSize(track_size);
+			track_shape.setFillColor(track_color);
+
+			fill_shape.setPosition(track_shape.getPosition());
+			fill_shape.setFillColor(fill_color);
+
+			knob_shape.setRadius(knob_radius);
+			knob_shape.setOrigin(knob_radius, knob_radius);
+			knob_shape.setFillColor(knob_color);
+
+			setValue(initial_value);
+		}
+
+		void SliderView::update()
+		{
+			UIView::update();
+
+			if (ui_state == UIState::VISIBLE)
+			{
+				handleSliderInteraction();
+			}
+		}
+
+		void SliderView::render()
+		{
+			UIView::render();
+
+			if (ui_state == UIState::VISIBLE)
+			{
+				draw(track_shape);
+				draw(fill_shape);
+				draw(knob_shape);
+			}
+		}
+
+		void SliderView::handleSliderInteraction()
+		{
+			sf::Vector2f mouse_position = sf::Vector2f(sf::Mouse::getPosition(*game_window));
+
+			if (!dragging)
+			{
+				sf::FloatRect grab_bounds = track_shape.getGlobalBounds();
+				grab_bounds.top -= knob_shape.getRadius();
+				grab_bounds.height += 2.f * knob_shape.getRadius();
+
+				dragging = ServiceLocator::getInstance()->getEventService()->pressedLeftMouseButton() && grab_bounds.contains(mouse_position);
+				if (!dragging) return;
+			}
+
+			float ratio = (mouse_position.x - track_shape.getPosition().x) / track_shape.getSize().x;
+			value = ratioToValue(std::max(0.f, std::min(ratio, 1.f)));
+			updateShapes();
+
+			if (!sf::Mouse::isButtonPressed(sf::Mouse::Left))
+			{
+				dragging = false;
+				if (callback_function) callback_function(value);
+			}
+		}
+
+		float SliderView::valueToRatio(float slider_value) const
+		{
+			if (max_value <= min_value) return 0.f;
+			if (logarithmic) return std::log(slider_value / min_value) / std::log(max_value / min_value);
+			return (slider_value - min_value) / (max_value - min_value);
+		}
+
+		float SliderView::ratioToValue(float ratio) const
+		{
+			if (logarithmic) return min_value * std::pow(max_value / min_value, ratio);
+			return min_value + ratio * (max_value - min_value);
+		}
+
+		void SliderView::updateShapes()
+		{
+			float knob_x = track_shape.getPosition().x + valueToRatio(value) * track_shape.getSize().x;
+
+			fill_shape.setSize(sf::Vector2f(knob_x - track_shape.getPosition().x, track_shape.getSize().y));
+			knob_shape.setPosition(knob_x, track_shape.getPosition().y + track_shape.getSize().y * 0.5f);
+		}
+
+		void SliderView::setValue(float slider_value)
+		{
+			value = std::max(min_value, std::min(slider_value, max_value));
+			updateShapes();
+		}
+
+		float SliderView::getValue() const { return value; }
+
+		bool SliderView::isDragging() const { return dragging; }
+
+		void SliderView::registerCallbackFuntion(CallbackFunction slider_callback)
+		{
+			callback_function = slider_callback;
+		}
+	}
+}
@@ -1,5 +1,7 @@
 #include "UI/UIElement/TextView.h"
 #include "Global/Config.h"
+#include "Global/ServiceLocator.h"
+#include "Resource/ResourceService.h"
 
 namespace UI
 {
@@ -7,9 +9,6 @@ namespace UI
 	{
 		using namespace Global;
 
-		sf::Font TextView::font_bubble_bobble;
-		sf::Font TextView::font_DS_DIGIB;
-
 		TextView::TextView() = default;
 
 		TextView::~TextView() = default;
@@ -36,7 +35,7 @@ namespace UI
 
 			if (ui_state == UIState::VISIBLE)
 			{
-				game_window->draw(text);
+				draw(text);
 			}
 		}
 
@@ -47,8 +46,10 @@ namespace UI
 
 		void TextView::loadFont()
 		{
-			font_bubble_bobble.loadFromFile(Config::bubble_bobble_font_path);
-			font_DS_DIGIB.loadFromFile(Config::DS_DIGIB_font_path);
+			Resource::ResourceService* resource_service = ServiceLocator::getInstance()->getResourceService();
+
+			resource_service->getFont(Config::bubble_bobble_font_path);
+			resource_service->getFont(Config::DS_DIGIB_font_path);
 		}
 
 		void TextView::setText(sf::String text_value)
@@ -58,15 +59,20 @@ namespace UI
 
 		void TextView::setFont(FontType font_type)
 		{
+			sf::Font* font = nullptr;
+			Resource::ResourceService* resource_service = ServiceLocator::getInstance()->getResourceService();
+
 			switch (font_type)
 			{
 			case FontType::BUBBLE_BOBBLE:
-				text.setFont(font_bubble_bobble);
+				font = resource_service->getFont(Config::bubble_bobble_font_path);
 				break;
 			case FontType::DS_DIGIB:
-				text.setFont(font_DS_DIGIB);
+				font = resource_service->getFont(Config::DS_DIGIB_font_path);
 				break;
 			}
+
+			if (font) text.setFont(*font);
 		}
 
 		void TextView::setFontSize(int font_size)
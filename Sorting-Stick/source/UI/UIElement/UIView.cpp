@@ -1,6 +1,7 @@
 #include "UI/UIElement/UIView.h"
 #include "Global/ServiceLocator.h"
 #include "Graphics/GraphicService.h"
+#include "Profiling/ProfilingService.h"
 
 namespace UI
 {
@@ -53,5 +54,11 @@ namespace UI
 
 			return sf::Vector2f(adjusted_width, adjusted_height);
 		}
+
+		void UIView::draw(const sf::Drawable& drawable)
+		{
+			game_window->draw(drawable);
+			ServiceLocator::getInstance()->getProfilingService()->recordDrawCall();
+		}
 	}
 }
\ No newline at end of file
@@ -10,12 +10,15 @@ namespace UI
 	using namespace UIElement;
 	using namespace Interface;
 	using namespace GameplayUI;
+	using namespace PerformanceOverlay;
 
 	UIService::UIService()
 	{
 		splash_screen_controller = nullptr;
 		main_menu_controller = nullptr;
 		gameplay_controller = nullptr;
+		performance_overlay_controller = nullptr;
+		asset_dependent_controllers_initialized = false;
 
 		createControllers();
 	}
@@ -25,6 +28,7 @@ namespace UI
 		splash_screen_controller = new SplashScreenUIController();
 		main_menu_controller = new MainMenuUIController();
 		gameplay_controller = new GameplayUIController();
+		performance_overlay_controller = new PerformanceOverlayUIController();
 	}
 
 	UIService::~UIService()
@@ -32,22 +36,36 @@ namespace UI
 		destroy();
 	}
 
+	// Only the splash screen is initialized up front; it is the one screen that can be shown while assets load.
 	void UIService::initialize()
+	{
+		splash_screen_controller->initialize();
+	}
+
+	void UIService::initializeAssetDependentControllers()
 	{
 		TextView::initializeTextView();
-		initializeControllers();
+		main_menu_controller->initialize();
+		gameplay_controller->initialize();
+		performance_overlay_controller->initialize();
+
+		asset_dependent_controllers_initialized = true;
 	}
 
 	void UIService::update()
 	{
 		IUIController* ui_controller = getCurrentUIController();
 		if (ui_controller) ui_controller->update();
+
+		if (asset_dependent_controllers_initialized) performance_overlay_controller->update();
 	}
 
 	void UIService::render()
 	{
 		IUIController* ui_controller = getCurrentUIController();
 		if (ui_controller) ui_controller->render();
+
+		if (asset_dependent_controllers_initialized) performance_overlay_controller->render();
 	}
 
 	void UIService::showScreen()
@@ -56,13 +74,6 @@ namespace UI
 		if (ui_controller) ui_controller->show();
 	}
 
-	void UIService::initializeControllers()
-	{
-		splash_screen_controller->initialize();
-		main_menu_controller->initialize();
-		gameplay_controller->initialize();
-	}
-
 	IUIController* UIService::getCurrentUIController()
 	{
 		switch (GameService::getGameState())
@@ -86,5 +97,6 @@ namespace UI
 		delete(splash_screen_controller);
 		delete(main_menu_controller);
 		delete(gameplay_controller);
+		delete(performance_overlay_controller);
 	}
 }
\ No newline at end of file
@@ -0,0 +1,63 @@
+#!/usr/bin/env python3
+"""Packs everything under the assets directory into a single indexed archive.
+
+Usage: pack_assets.py <assets_dir> <output_file>
+
+The layout matches Resource::AssetArchive (little endian):
+    char[4] "SSPK", uint32 version, uint32 entry_count,
+    entry_count x (uint32 path_length, path bytes, uint64 offset, uint64 size),
+    file contents, each aligned to 16 bytes.
+Paths are stored relative to the parent of the assets directory with forward
+slashes, e.g. "assets/textures/play_button.png", matching Config.cpp.
+"""
+import os
+import struct
+import sys
+
+MAGIC = b"SSPK"
+VERSION = 1
+ALIGNMENT = 16
+
+
+def collect(assets_dir):
+    root = os.path.dirname(os.path.abspath(assets_dir))
+    files = []
+    for directory, _, names in os.walk(assets_dir):
+        for name in sorted(names):
+            full_path = os.path.join(directory, name)
+            relative = os.path.relpath(full_path, root).replace(os.sep, "/")
+            files.append((relative, full_path))
+    return sorted(files)
+
+
+def pack(assets_dir, output_file):
+    files = collect(assets_dir)
+
+    index_size = 12 + sum(4 + len(path.encode("utf-8")) + 16 for path, _ in files)
+    offset = (index_size + ALIGNMENT - 1) // ALIGNMENT * ALIGNMENT
+
+    index = bytearray(MAGIC + struct.pack("<II", VERSION, len(files)))
+    blobs = []
+    for path, full_path in files:
+        with open(full_path, "rb") as source:
+            data = source.read()
+        encoded = path.encode("utf-8")
+        index += struct.pack("<I", len(encoded)) + encoded + struct.pack("<QQ", offset, len(data))
+        blobs.append((offset, data))
+        offset = (offset + len(data) + ALIGNMENT - 1) // ALIGNMENT * ALIGNMENT
+
+    temporary_file = output_file + ".tmp"
+    with open(temporary_file, "wb") as archive:
+        archive.write(index)
+        for blob_offset, data in blobs:
+            archive.write(b"\0" * (blob_offset - archive.tell()))
+            archive.write(data)
+    os.replace(temporary_file, output_file)
+
+    print("Packed %d assets into %s (%d bytes)" % (len(files), output_file, offset))
+
+
+if __name__ == "__main__":
+    if len(sys.argv) != 3:
+        sys.exit(__doc__)
+    pack(sys.argv[1], sys.argv[2])